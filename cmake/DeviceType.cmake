@@ -0,0 +1,97 @@
+# Device selection shared by the RP2040 build and the host build (host/).
+#
+# Expects DEVICE_TYPE to be set, optionally DEVICE_ADDRESS, CLKDIV and LOG_LEVEL.
+# Sets compile definitions __DEVICE_ADDRESS, __CLKDIV, _LOG_LEVEL, __SHIELD_<X>
+# and __DEVICE_CLASS for all targets of the including directory, RING_BUFFER_LEN
+# for device classes with statistics window other than the default.
+
+set(DEVICE_TYPE_HINT "Possible options for SENSOR_TYPE: SCL3300, SCL3300a, "
+"SCL3400, AI, DiscreteAI, 4DI4DO, ABP, hx711, Encoder, Cutter, EnviroLS, temp")
+
+if(NOT DEFINED DEVICE_ADDRESS)
+    set(DEVICE_ADDRESS 0)
+endif()
+
+message("DEVICE_ADDRESS set to ${DEVICE_ADDRESS}")
+add_compile_definitions(__DEVICE_ADDRESS=${DEVICE_ADDRESS})
+
+# check if ${CLKDIV} is set and set it to 4 if not - necessary for some boards
+if(NOT DEFINED CLKDIV)
+	set(CLKDIV 4)
+endif()
+add_compile_definitions(__CLKDIV=${CLKDIV})
+
+if(NOT DEFINED LOG_LEVEL)
+	set(LOG_LEVEL 1)
+endif()
+add_compile_definitions(_LOG_LEVEL=${LOG_LEVEL})
+if(${LOG_LEVEL} EQUAL 1)
+    message("LOG_LEVEL set to ${LOG_LEVEL} = ERROR")
+elseif(${LOG_LEVEL} EQUAL 2)
+    message("LOG_LEVEL set to ${LOG_LEVEL} = WARNING")
+elseif(${LOG_LEVEL} EQUAL 3)
+    message("LOG_LEVEL set to ${LOG_LEVEL} = INFO")
+elseif(${LOG_LEVEL} EQUAL 4)
+    message("LOG_LEVEL set to ${LOG_LEVEL} = DEBUG")
+elseif(${LOG_LEVEL} EQUAL 5)
+    message("LOG_LEVEL set to ${LOG_LEVEL} = TRACE")
+endif()
+
+# check if ${DEVICE_TYPE} is set
+if(NOT DEFINED DEVICE_TYPE)
+	message(FATAL_ERROR "DEVICE_TYPE not set, use -DSENSOR_TYPE=...\n${DEVICE_TYPE_HINT}")
+endif()
+
+# this is the sensor type we are using, we need to set this to use the correct sensor header
+if(${DEVICE_TYPE} STREQUAL "SCL3300")
+	add_compile_definitions(__SHIELD_SCL3300)
+	add_compile_definitions(__DEVICE_CLASS=SCL3300)
+elseif(${DEVICE_TYPE} STREQUAL "SCL3300a")
+	add_compile_definitions(__SHIELD_SCL3300)
+	add_compile_definitions(__DEVICE_CLASS=SCL3300a)
+	add_compile_definitions(RING_BUFFER_LEN=70)  # 1s at 70Hz
+elseif(${DEVICE_TYPE} STREQUAL "SCL3400")
+	add_compile_definitions(__SHIELD_SCL3400)
+	add_compile_definitions(__DEVICE_CLASS=SCL3400)
+elseif(${DEVICE_TYPE} STREQUAL "AI")
+	add_compile_definitions(__SHIELD_AI)
+	add_compile_definitions(__DEVICE_CLASS=AnalogInput)
+elseif(${DEVICE_TYPE} STREQUAL "AnalogInput")
+	add_compile_definitions(__SHIELD_AI)
+	add_compile_definitions(__DEVICE_CLASS=AnalogInput)
+elseif(${DEVICE_TYPE} STREQUAL "4DI4DO")
+	add_compile_definitions(__SHIELD_4DI4DO)
+	add_compile_definitions(__DEVICE_CLASS=_4DI4DO)
+elseif(${DEVICE_TYPE} STREQUAL "ABP")
+	add_compile_definitions(__SHIELD_ABP)
+	add_compile_definitions(__DEVICE_CLASS=ABP)
+elseif(${DEVICE_TYPE} STREQUAL "hx711")
+	add_compile_definitions(__SHIELD_HX711)
+	add_compile_definitions(__DEVICE_CLASS=HX711)
+	add_compile_definitions(RING_BUFFER_LEN=80)  # 1s at 80Hz
+elseif(${DEVICE_TYPE} STREQUAL "Encoder")
+    add_compile_definitions(__SHIELD_ENCODER)
+    add_compile_definitions(__DEVICE_CLASS=Encoder)
+elseif(${DEVICE_TYPE} STREQUAL "Cutter")
+    add_compile_definitions(__SHIELD_CUTTER)
+    add_compile_definitions(__TIGHTLOOP)
+    add_compile_definitions(__DEVICE_CLASS=Cutter)
+elseif(${DEVICE_TYPE} STREQUAL "temp")
+    add_compile_definitions(__SHIELD_TEMP)
+    add_compile_definitions(__DEVICE_CLASS=DS18B20)
+    add_compile_definitions(RING_BUFFER_LEN=5)  # 5s at 1Hz
+elseif(${DEVICE_TYPE} STREQUAL "EnviroLS")
+    add_compile_definitions(__SHIELD_ENVIROLS)
+    add_compile_definitions(__DEVICE_CLASS=LightSound)
+elseif(${DEVICE_TYPE} STREQUAL "DiscreteAI")
+    add_compile_definitions(__SHIELD_DISCRETE_AI)
+    add_compile_definitions(__DEVICE_CLASS=DiscreteAnalog)
+    add_compile_definitions(RING_BUFFER_LEN=50)  # 1s at 50Hz
+else()
+	message(FATAL_ERROR "DEVICE_TYPE '${DEVICE_TYPE}' is incorrect, use -DDEVICE_TYPE=...\n${DEVICE_TYPE_HINT}")
+endif()
+
+# print warning to clearly show which device type is used and which CLKDIV is set
+message(WARNING "\nDEVICE_TYPE set to '${DEVICE_TYPE}'."
+	"\nCLKDIV set to ${CLKDIV}, increase this "
+	"value if device is not responding after reboot.")
@@ -0,0 +1,50 @@
+# Firmware sources and version shared by the RP2040 build, the host build (host/)
+# and the host benchmarks (tests/benchmarks).
+#
+# Sets XERXES_ROOT_DIR, FIRMWARE_LIBRARY_SOURCES (everything that does not depend
+# on the selected __DEVICE_CLASS) and FIRMWARE_APP_SOURCES (entry point, callbacks
+# and board init which bind the global device, register and queues).
+
+get_filename_component(XERXES_ROOT_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+
+# parse version and build number from git
+execute_process(
+    COMMAND git describe --long
+    WORKING_DIRECTORY ${XERXES_ROOT_DIR}
+    OUTPUT_VARIABLE VERSION
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+add_compile_definitions(__VERSION="${VERSION}")
+
+set(FIRMWARE_LIBRARY_SOURCES
+	${XERXES_ROOT_DIR}/src/Hardware/ClockUtils.cpp
+	${XERXES_ROOT_DIR}/src/Hardware/Sleep.cpp
+	${XERXES_ROOT_DIR}/src/Hardware/UserFlash.cpp
+	${XERXES_ROOT_DIR}/src/Communication/RS485.cpp
+	${XERXES_ROOT_DIR}/src/Communication/UartRxRing.cpp
+	${XERXES_ROOT_DIR}/src/Communication/UartTxRing.cpp
+	${XERXES_ROOT_DIR}/src/Core/Slave.cpp
+	${XERXES_ROOT_DIR}/src/Core/Register.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Peripheral.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Sensor.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/AnalogInput.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/DiscreteAnalog.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/DIO/DigitalInputOutput.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/DIO/4DI4DO.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Murata/SCL3X00.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Murata/SCL3300.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Murata/SCL3300a.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Murata/SCL3400.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Honeywell/ABP.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/hx711.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/DIO/Encoder.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/DIO/Cutter.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/ds18b20/ds18b20.cpp
+	${XERXES_ROOT_DIR}/src/Sensors/Generic/Enviro/LightSound.cpp
+)
+
+set(FIRMWARE_APP_SOURCES
+	${XERXES_ROOT_DIR}/src/Communication/Callbacks.cpp
+	${XERXES_ROOT_DIR}/src/Hardware/InitUtils.cpp
+	${XERXES_ROOT_DIR}/src/main.cpp
+)
@@ -0,0 +1,60 @@
+#ifndef __HOST_ABP_MODEL_HPP
+#define __HOST_ABP_MODEL_HPP
+
+#include <mutex>
+#include "HostHal.hpp"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+/**
+ * @brief Honeywell ABP pressure sensor with SPI output and temperature
+ *
+ * Transfer function 10% to 90% of 2^14 counts over the pressure range,
+ * temperature as 11 bit value over -50..150°C. Sampled on the first byte
+ * clocked out after chip select.
+ */
+class AbpModel : public SpiDevice
+{
+public:
+    /**
+     * @brief Construct the model
+     *
+     * @param pMin pressure at 10% counts in Pa
+     * @param pMax pressure at 90% counts in Pa
+     */
+    AbpModel(double pMin = 0, double pMax = 6000);
+
+    /// @brief Pressure in Pa
+    void setPressure(Signal pascal);
+
+    /// @brief Temperature in °C
+    void setTemperature(Signal celsius);
+
+    void select(bool selected) override;
+    void transfer(const uint8_t *tx, uint8_t *rx, size_t len) override;
+
+private:
+    /// @brief convert the signals into the output frame, lock must be held
+    void sample();
+
+    std::mutex lock;
+    double pMin;
+    double pMax;
+    Signal pressure;
+    Signal temperature;
+
+    uint8_t data[4] {};
+    size_t position = 0;
+};
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+#endif // !__HOST_ABP_MODEL_HPP
@@ -0,0 +1,47 @@
+#ifndef __HOST_ADS1115_MODEL_HPP
+#define __HOST_ADS1115_MODEL_HPP
+
+#include <mutex>
+#include "HostHal.hpp"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+/**
+ * @brief TI ADS1115 16 bit ADC on I2C
+ *
+ * Single ended inputs AIN0..AIN3 follow the attached signals, conversions
+ * complete immediately. Differential multiplexer settings are supported.
+ */
+class Ads1115Model : public I2cDevice
+{
+public:
+    Ads1115Model();
+
+    /// @brief Voltage on AIN0..AIN3 in volts
+    void setInput(uint channel, Signal volts);
+
+    int write(const uint8_t *src, size_t len, bool nostop) override;
+    int read(uint8_t *dst, size_t len, bool nostop) override;
+
+private:
+    int16_t convert();
+
+    std::mutex lock;
+    Signal inputs[4];
+    uint8_t pointer = 0;
+    uint16_t config = 0x8583;  // power on default
+    int16_t conversion = 0;
+    uint16_t thresholds[2] = {0x8000, 0x7FFF};
+};
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+#endif // !__HOST_ADS1115_MODEL_HPP
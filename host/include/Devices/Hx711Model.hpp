@@ -0,0 +1,55 @@
+#ifndef __HOST_HX711_MODEL_HPP
+#define __HOST_HX711_MODEL_HPP
+
+#include <mutex>
+#include "HostHal.hpp"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+/**
+ * @brief Avia HX711 24 bit bridge ADC, channel A gain 128
+ *
+ * Serial clock and data out are bit-banged on two GPIOs. A conversion is
+ * always ready (DOUT low), the value is sampled on the first clock pulse and
+ * shifted out MSB first on the following rising edges.
+ */
+class Hx711Model : public GpioDevice
+{
+public:
+    /**
+     * @brief Construct the model
+     *
+     * @param sckPin serial clock, output of the firmware
+     * @param doutPin data out, input of the firmware
+     */
+    Hx711Model(uint sckPin, uint doutPin);
+
+    /// @brief Differential input in ADC counts (±2^23)
+    void setInput(Signal counts);
+
+    void output(uint gpio, bool level) override;
+    bool input(uint gpio) override;
+
+private:
+    std::mutex lock;
+    uint sckPin;
+    uint doutPin;
+    Signal counts;
+
+    bool sck = false;
+    bool dout = false;
+    uint pulses = 0;
+    uint32_t shift = 0;
+};
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+#endif // !__HOST_HX711_MODEL_HPP
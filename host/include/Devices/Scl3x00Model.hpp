@@ -0,0 +1,67 @@
+#ifndef __HOST_SCL3X00_MODEL_HPP
+#define __HOST_SCL3X00_MODEL_HPP
+
+#include <array>
+#include <mutex>
+#include "HostHal.hpp"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+/**
+ * @brief Murata SCL3300/SCL3400 inclinometer on SPI
+ *
+ * Implements the off-frame protocol: the reply to a command is shifted out
+ * during the next frame. Acceleration is derived from the inclination
+ * (1g field), angles and temperature follow the attached signals.
+ */
+class Scl3x00Model : public SpiDevice
+{
+public:
+    /**
+     * @brief Construct the model
+     *
+     * @param sensitivity acceleration sensitivity in LSB/g for modes 1..4
+     */
+    explicit Scl3x00Model(const std::array<double, 4> &sensitivity);
+
+    /// @brief SCL3300: 6000, 3000, 12000 and 12000 LSB/g
+    static Scl3x00Model scl3300();
+
+    /// @brief SCL3400: 32768 LSB/g in both modes
+    static Scl3x00Model scl3400();
+
+    /// @brief Inclination of axis 0..2 (X, Y, Z) in degrees
+    void setAngle(uint axis, Signal degrees);
+
+    /// @brief Die temperature in °C
+    void setTemperature(Signal celsius);
+
+    void select(bool selected) override;
+    void transfer(const uint8_t *tx, uint8_t *rx, size_t len) override;
+
+private:
+    uint32_t reply(uint32_t command);
+    uint32_t frame(uint8_t address, uint16_t data) const;
+
+    std::mutex lock;
+    std::array<double, 4> sensitivity;
+    Signal angle[3];
+    Signal temperature;
+
+    uint8_t mode = 0;
+    uint32_t shiftIn = 0;
+    uint32_t nextReply = 0;
+    size_t position = 0;
+};
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+#endif // !__HOST_SCL3X00_MODEL_HPP
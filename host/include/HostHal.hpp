@@ -0,0 +1,215 @@
+#ifndef __HOST_HAL_HPP
+#define __HOST_HAL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#include "pico.h"
+#include "hardware/spi.h"
+#include "hardware/i2c.h"
+
+
+namespace Xerxes
+{
+
+/**
+ * @brief Control interface of the simulated Pico HAL used by the host build
+ *
+ * The firmware talks to the pico-sdk API declared in host/include, the
+ * simulation is steered from outside (tests, benchmarks, Shield.cpp) through
+ * the functions below: analog and digital inputs are driven by signal
+ * generators, buses are served by device models attached to them.
+ */
+namespace Sim
+{
+
+
+/// @brief Signal generator, returns value of the signal at given time in microseconds
+typedef std::function<double(uint64_t timeUs)> Signal;
+
+
+/// @brief Constant signal
+Signal constant(double value);
+
+/**
+ * @brief Sine wave
+ *
+ * @param amplitude peak amplitude
+ * @param frequencyHz frequency in Hz
+ * @param offset DC offset
+ * @param phaseRad phase shift in radians
+ */
+Signal sine(double amplitude, double frequencyHz, double offset = 0, double phaseRad = 0);
+
+/**
+ * @brief Gaussian white noise, every call draws a new sample
+ *
+ * @param stdDev standard deviation
+ * @param mean mean value
+ * @param seed seed of the generator, same seed gives the same sequence
+ */
+Signal noise(double stdDev, double mean = 0, uint32_t seed = 1);
+
+/**
+ * @brief Linear ramp
+ *
+ * @param slopePerSecond increment per second
+ * @param offset value at time 0
+ */
+Signal ramp(double slopePerSecond, double offset = 0);
+
+/**
+ * @brief Square wave between low and high
+ *
+ * @param low value of the first half period
+ * @param high value of the second half period
+ * @param frequencyHz frequency in Hz
+ */
+Signal square(double low, double high, double frequencyHz);
+
+/**
+ * @brief Quadrature output of an incremental encoder
+ *
+ * @param positionCounts position of the encoder in counts (edges)
+ * @param channel 0 for channel A, 1 for channel B (leading A by 90° for increasing position)
+ */
+Signal quadrature(Signal positionCounts, uint channel);
+
+/// @brief Sum of two signals
+Signal operator+(Signal a, Signal b);
+
+/// @brief Product of two signals
+Signal operator*(Signal a, Signal b);
+
+
+/// @brief Source of time_us_64()
+enum class TimeMode
+{
+    REAL,    ///< monotonic host clock, sleeps block the calling thread
+    VIRTUAL  ///< virtual clock, sleeps return immediately and advance the clock
+};
+
+/**
+ * @brief Select the time source, both modes start at 0
+ *
+ * Virtual time suits single threaded benchmarks and tests where the device
+ * update should not wait for the real cycle time.
+ */
+void setTimeMode(TimeMode mode);
+
+/// @brief Current time source
+TimeMode getTimeMode();
+
+/// @brief Advance the virtual clock, no-op in real time mode
+void advanceTime(uint64_t us);
+
+
+/**
+ * @brief Drive ADC input with a signal
+ *
+ * @param channel 0..3 for ADC0_PIN..ADC3_PIN, 4 for the temperature sensor
+ * @param volts signal in volts, clamped to <0, 3.3V>
+ */
+void setAdcSignal(uint channel, Signal volts);
+
+/**
+ * @brief Drive input pin with a signal, values above 0.5 read as high
+ *
+ * Empty signal detaches the generator, the pin reads the pull resistor again.
+ */
+void setGpioSignal(uint gpio, Signal level);
+
+
+/// @brief Device on a SPI bus, selected by its chip select pin
+class SpiDevice
+{
+public:
+    virtual ~SpiDevice() = default;
+
+    /// @brief Chip select changed, called on every edge of the CS pin
+    virtual void select(bool selected) { (void)selected; }
+
+    /// @brief Shift len bytes in and out, rx is never null
+    virtual void transfer(const uint8_t *tx, uint8_t *rx, size_t len) = 0;
+};
+
+/// @brief Device on an I2C bus, addressed by its 7 bit address
+class I2cDevice
+{
+public:
+    virtual ~I2cDevice() = default;
+
+    /// @brief Master writes len bytes, return number of bytes acked
+    virtual int write(const uint8_t *src, size_t len, bool nostop) = 0;
+
+    /// @brief Master reads len bytes, return number of bytes read
+    virtual int read(uint8_t *dst, size_t len, bool nostop) = 0;
+};
+
+/// @brief Device bit-banged over GPIO pins, e.g. HX711
+class GpioDevice
+{
+public:
+    virtual ~GpioDevice() = default;
+
+    /// @brief Firmware changed an output the device is attached to
+    virtual void output(uint gpio, bool level) { (void)gpio; (void)level; }
+
+    /// @brief Level the device drives on an input it is attached to
+    virtual bool input(uint gpio) = 0;
+};
+
+
+/**
+ * @brief Attach device to SPI bus, device is not owned
+ *
+ * @param spi bus instance
+ * @param csPin chip select pin, active low
+ * @param device device model, nullptr detaches
+ */
+void attachSpiDevice(spi_inst_t *spi, uint csPin, SpiDevice *device);
+
+/// @brief Attach device to I2C bus at 7 bit address, device is not owned, nullptr detaches
+void attachI2cDevice(i2c_inst_t *i2c, uint8_t address, I2cDevice *device);
+
+/// @brief Attach device to a pin, device is not owned, nullptr detaches
+void attachGpioDevice(uint gpio, GpioDevice *device);
+
+
+/**
+ * @brief Fire the GPIO callback as if the events occurred on the pin
+ *
+ * Edges of signal driven inputs are detected automatically by a poller
+ * (every 20us) once a GPIO IRQ is enabled; this is for deterministic tests.
+ */
+void triggerGpioIrq(uint gpio, uint32_t events);
+
+
+/// @brief Wire time of UART frames, enabled by default
+void setUartWireTiming(bool enabled);
+
+/**
+ * @brief Bytes arrive on the RX line of the UART now, without wire time
+ *
+ * Same path as bytes from the pty: RX FIFO, DMA and RX IRQ. For tests which
+ * do not open the pty.
+ */
+void receiveUart(uint index, const uint8_t *src, size_t len);
+
+/// @brief Called with every byte the firmware transmits on the UART
+typedef std::function<void(uint8_t byte)> UartListener;
+
+/// @brief Listen to the TX line of the UART next to the pty, empty listener detaches
+void setUartListener(uint index, UartListener listener);
+
+
+/// @brief Detach all devices and signals, restore time, pins and flash to power on state
+void reset();
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+#endif // !__HOST_HAL_HPP
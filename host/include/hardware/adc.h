@@ -0,0 +1,22 @@
+#ifndef __HOST_HARDWARE_ADC_H
+#define __HOST_HARDWARE_ADC_H
+
+#include "pico.h"
+
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+void adc_set_temp_sensor_enabled(bool enable);
+
+/**
+ * @brief Convert the selected input
+ *
+ * Samples the signal generator attached to the input (volts, 3.3V reference)
+ * and returns the 12 bit code.
+ */
+uint16_t adc_read(void);
+
+
+#endif // !__HOST_HARDWARE_ADC_H
@@ -0,0 +1,56 @@
+#ifndef __HOST_HARDWARE_CLOCKS_H
+#define __HOST_HARDWARE_CLOCKS_H
+
+#include "pico.h"
+
+
+#define KHZ 1000
+#define MHZ 1000000
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+// clock source selectors, values as in hardware/regs/clocks.h
+#define CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLK_REF                   0x0
+#define CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX        0x1
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS         0x0
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB         0x1
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS               0x0
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS        0x1
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB        0x2
+#define CLOCKS_CLK_USB_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB         0x0
+#define CLOCKS_CLK_ADC_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB         0x0
+
+// frequency counter sources
+#define CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY             0x01
+#define CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY             0x02
+#define CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC                        0x03
+#define CLOCKS_FC0_SRC_VALUE_CLK_REF                            0x08
+#define CLOCKS_FC0_SRC_VALUE_CLK_SYS                            0x09
+#define CLOCKS_FC0_SRC_VALUE_CLK_PERI                           0x0a
+#define CLOCKS_FC0_SRC_VALUE_CLK_USB                            0x0b
+#define CLOCKS_FC0_SRC_VALUE_CLK_ADC                            0x0c
+#define CLOCKS_FC0_SRC_VALUE_CLK_RTC                            0x0d
+
+
+/// @brief Record the requested frequency, returned by clock_get_hz()
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq);
+void clock_stop(enum clock_index clk_index);
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+/// @brief Frequency of a counter source in kHz as configured, 0 for stopped clocks
+uint32_t frequency_count_khz(uint src);
+
+
+#endif // !__HOST_HARDWARE_CLOCKS_H
@@ -0,0 +1,85 @@
+#ifndef __HOST_HARDWARE_DMA_H
+#define __HOST_HARDWARE_DMA_H
+
+#include "pico.h"
+#include "hardware/regs/dreq.h"
+
+
+#define NUM_DMA_CHANNELS 12
+
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+
+/**
+ * @brief Channel configuration, plain fields instead of the packed CTRL word of the pico-sdk
+ *
+ * Only 8 bit transfers are simulated.
+ */
+typedef struct {
+    bool read_increment;
+    bool write_increment;
+    uint dreq;
+    uint ring_size_bits;    ///< 0 for no wrapping
+    bool ring_write;        ///< ring wraps the write address, else the read address
+    enum dma_channel_transfer_size size;
+} dma_channel_config;
+
+
+/**
+ * @brief Live registers of a channel
+ *
+ * Addresses are pointer wide on host. transfer_count counts down while the
+ * channel runs, as on the chip.
+ */
+typedef struct {
+    volatile uintptr_t read_addr;
+    volatile uintptr_t write_addr;
+    volatile uint32_t transfer_count;
+} dma_channel_hw_t;
+
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel);
+
+void dma_channel_claim(uint channel);
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+bool dma_channel_is_claimed(uint channel);
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits);
+
+/**
+ * @brief Set up the channel, with trigger it starts right away
+ *
+ * A paced channel moves one byte whenever its DREQ is ready, e.g. for each
+ * byte in the RX FIFO of the UART. The TX FIFO of the UART takes bytes
+ * without wire time, a channel paced by it completes at once like an
+ * unpaced channel (DREQ_FORCE).
+ */
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+
+/// @brief Set the count loaded on the next trigger, with trigger start the channel now
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+
+/// @brief Completion of the channel raises DMA_IRQ_0
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+
+
+#endif // !__HOST_HARDWARE_DMA_H
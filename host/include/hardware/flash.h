@@ -0,0 +1,26 @@
+#ifndef __HOST_HARDWARE_FLASH_H
+#define __HOST_HARDWARE_FLASH_H
+
+#include "pico.h"
+
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+#define FLASH_UNIQUE_ID_SIZE_BYTES 8
+
+/// @brief Simulated flash chip of PICO_FLASH_SIZE_BYTES, erased (0xFF) at start
+extern uint8_t host_flash_image[];
+
+/// @brief Memory mapped flash, reads go directly to the simulated image
+#define XIP_BASE ((uintptr_t)host_flash_image)
+
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+/// @brief Unique ID of the simulated chip, XERXES_HOST_UID if set, else a fixed ID
+void flash_get_unique_id(uint8_t *id_out);
+
+
+#endif // !__HOST_HARDWARE_FLASH_H
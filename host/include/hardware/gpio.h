@@ -0,0 +1,84 @@
+#ifndef __HOST_HARDWARE_GPIO_H
+#define __HOST_HARDWARE_GPIO_H
+
+#include "pico.h"
+#include "hardware/irq.h"
+
+
+#define NUM_BANK0_GPIOS     30
+
+#define GPIO_OUT            1
+#define GPIO_IN             0
+
+
+enum gpio_function {
+    GPIO_FUNC_XIP = 0,
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8,
+    GPIO_FUNC_USB = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u,
+    GPIO_IRQ_LEVEL_HIGH = 0x2u,
+    GPIO_IRQ_EDGE_FALL = 0x4u,
+    GPIO_IRQ_EDGE_RISE = 0x8u,
+};
+
+enum gpio_drive_strength {
+    GPIO_DRIVE_STRENGTH_2MA = 0,
+    GPIO_DRIVE_STRENGTH_4MA = 1,
+    GPIO_DRIVE_STRENGTH_8MA = 2,
+    GPIO_DRIVE_STRENGTH_12MA = 3
+};
+
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+
+void gpio_init(uint gpio);
+void gpio_init_mask(uint gpio_mask);
+void gpio_deinit(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+enum gpio_function gpio_get_function(uint gpio);
+
+void gpio_set_dir(uint gpio, bool out);
+void gpio_set_dir_masked(uint32_t mask, uint32_t value);
+void gpio_set_dir_in_masked(uint32_t mask);
+void gpio_set_dir_out_masked(uint32_t mask);
+bool gpio_is_dir_out(uint gpio);
+
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+void gpio_disable_pulls(uint gpio);
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive);
+
+/**
+ * @brief Drive an output
+ *
+ * Devices attached through Xerxes::Sim::attachGpioDevice() observe the edge.
+ */
+void gpio_put(uint gpio, bool value);
+void gpio_put_masked(uint32_t mask, uint32_t value);
+void gpio_put_all(uint32_t value);
+
+/**
+ * @brief Read a pin
+ *
+ * Outputs read back their latch, inputs read the attached device, signal
+ * generator or pull resistor in this order.
+ */
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all(void);
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback);
+
+
+#endif // !__HOST_HARDWARE_GPIO_H
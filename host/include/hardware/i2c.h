@@ -0,0 +1,37 @@
+#ifndef __HOST_HARDWARE_I2C_H
+#define __HOST_HARDWARE_I2C_H
+
+#include "pico.h"
+
+
+/// @brief I2C instance, the pico-sdk uses the register block address instead
+typedef struct i2c_inst {
+    uint index;
+} i2c_inst_t;
+
+extern i2c_inst_t host_i2c_inst[2];
+
+#define i2c0 (&host_i2c_inst[0])
+#define i2c1 (&host_i2c_inst[1])
+
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t *i2c);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+
+/**
+ * @brief Write to the device attached at addr
+ *
+ * @return number of bytes written or PICO_ERROR_GENERIC if nobody acks the address
+ */
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+/**
+ * @brief Read from the device attached at addr
+ *
+ * @return number of bytes read or PICO_ERROR_GENERIC if nobody acks the address
+ */
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+
+#endif // !__HOST_HARDWARE_I2C_H
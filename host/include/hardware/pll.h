@@ -0,0 +1,23 @@
+#ifndef __HOST_HARDWARE_PLL_H
+#define __HOST_HARDWARE_PLL_H
+
+#include "pico.h"
+
+
+typedef struct pll_inst {
+    uint index;
+} pll_hw_t;
+
+typedef pll_hw_t *PLL;
+
+extern pll_hw_t host_pll_inst[2];
+
+#define pll_sys (&host_pll_inst[0])
+#define pll_usb (&host_pll_inst[1])
+
+
+void pll_init(PLL pll, uint ref_div, uint vco_freq, uint post_div1, uint post_div2);
+void pll_deinit(PLL pll);
+
+
+#endif // !__HOST_HARDWARE_PLL_H
@@ -0,0 +1,15 @@
+#ifndef __HOST_HARDWARE_REGS_DREQ_H
+#define __HOST_HARDWARE_REGS_DREQ_H
+
+
+/// @brief DMA transfer requests of the peripherals, only the UARTs are simulated
+enum dreq_num_rp2040 {
+    DREQ_UART0_TX = 20,
+    DREQ_UART0_RX = 21,
+    DREQ_UART1_TX = 22,
+    DREQ_UART1_RX = 23,
+    DREQ_FORCE = 63,    ///< unpaced, transfers run at full speed
+};
+
+
+#endif // !__HOST_HARDWARE_REGS_DREQ_H
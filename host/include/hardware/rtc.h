@@ -0,0 +1,10 @@
+#ifndef __HOST_HARDWARE_RTC_H
+#define __HOST_HARDWARE_RTC_H
+
+#include "pico.h"
+
+
+void rtc_init(void);
+
+
+#endif // !__HOST_HARDWARE_RTC_H
@@ -0,0 +1,49 @@
+#ifndef __HOST_HARDWARE_SPI_H
+#define __HOST_HARDWARE_SPI_H
+
+#include "pico.h"
+
+
+/// @brief SPI instance, the pico-sdk uses the register block address instead
+typedef struct spi_inst {
+    uint index;
+} spi_inst_t;
+
+extern spi_inst_t host_spi_inst[2];
+
+#define spi0 (&host_spi_inst[0])
+#define spi1 (&host_spi_inst[1])
+
+typedef enum {
+    SPI_CPHA_0 = 0,
+    SPI_CPHA_1 = 1
+} spi_cpha_t;
+
+typedef enum {
+    SPI_CPOL_0 = 0,
+    SPI_CPOL_1 = 1
+} spi_cpol_t;
+
+typedef enum {
+    SPI_LSB_FIRST = 0,
+    SPI_MSB_FIRST = 1
+} spi_order_t;
+
+
+uint spi_init(spi_inst_t *spi, uint baudrate);
+void spi_deinit(spi_inst_t *spi);
+uint spi_set_baudrate(spi_inst_t *spi, uint baudrate);
+void spi_set_format(spi_inst_t *spi, uint data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order);
+
+/**
+ * @brief Full duplex transfer with the device attached to the bus
+ *
+ * The device is selected by its chip select pin being driven low, see
+ * Xerxes::Sim::attachSpiDevice(). Without a selected device MISO reads 0xFF.
+ */
+int spi_write_read_blocking(spi_inst_t *spi, const uint8_t *src, uint8_t *dst, size_t len);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len);
+
+
+#endif // !__HOST_HARDWARE_SPI_H
@@ -0,0 +1,8 @@
+#ifndef __HOST_HARDWARE_STRUCTS_CLOCKS_H
+#define __HOST_HARDWARE_STRUCTS_CLOCKS_H
+
+// register structs are not simulated, the functional API is in hardware/clocks.h
+#include "hardware/clocks.h"
+
+
+#endif // !__HOST_HARDWARE_STRUCTS_CLOCKS_H
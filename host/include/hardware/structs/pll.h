@@ -0,0 +1,8 @@
+#ifndef __HOST_HARDWARE_STRUCTS_PLL_H
+#define __HOST_HARDWARE_STRUCTS_PLL_H
+
+// register structs are not simulated, the functional API is in hardware/pll.h
+#include "hardware/pll.h"
+
+
+#endif // !__HOST_HARDWARE_STRUCTS_PLL_H
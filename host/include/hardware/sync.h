@@ -0,0 +1,26 @@
+#ifndef __HOST_HARDWARE_SYNC_H
+#define __HOST_HARDWARE_SYNC_H
+
+#include "pico.h"
+
+
+/**
+ * @brief Enter a critical section shared with the simulated IRQ handlers
+ *
+ * Backed by a recursive mutex, every call must be paired with restore_interrupts().
+ *
+ * @return opaque status for restore_interrupts()
+ */
+uint32_t save_and_disable_interrupts(void);
+
+/// @brief Leave the critical section entered by save_and_disable_interrupts()
+void restore_interrupts(uint32_t status);
+
+static inline void __wfi(void) {}
+static inline void __wfe(void) {}
+static inline void __sev(void) {}
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __dsb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+
+#endif // !__HOST_HARDWARE_SYNC_H
@@ -0,0 +1,64 @@
+#ifndef __HOST_HARDWARE_UART_H
+#define __HOST_HARDWARE_UART_H
+
+#include "pico.h"
+#include "hardware/regs/dreq.h"
+
+
+/// @brief UART instance, the pico-sdk uses the register block address instead
+typedef struct uart_inst {
+    uint index;
+} uart_inst_t;
+
+extern uart_inst_t host_uart_inst[2];
+
+#define uart0 (&host_uart_inst[0])
+#define uart1 (&host_uart_inst[1])
+
+
+/// @brief Register block of the UART, on host only the data register as the DMA address
+typedef struct {
+    volatile uint32_t dr;
+} uart_hw_t;
+
+uart_hw_t *uart_get_hw(uart_inst_t *uart);
+
+/// @brief DREQ of the UART for DMA transfers to TX or from RX
+static inline uint uart_get_dreq(uart_inst_t *uart, bool is_tx)
+{
+    return DREQ_UART0_TX + uart->index * 2 + (is_tx ? 0 : 1);
+}
+
+
+/**
+ * @brief Open the UART, backed by a pseudo terminal on host
+ *
+ * The slave side of the pty is printed to stderr and, if XERXES_HOST_PTY_LINK is
+ * set, symlinked to that path, so the master can connect e.g. with pyserial.
+ *
+ * @return baudrate
+ */
+uint uart_init(uart_inst_t *uart, uint baudrate);
+void uart_deinit(uart_inst_t *uart);
+uint uart_set_baudrate(uart_inst_t *uart, uint baudrate);
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled);
+void uart_set_irq_enables(uart_inst_t *uart, bool rx_has_data, bool tx_needs_data);
+uint uart_get_index(uart_inst_t *uart);
+
+bool uart_is_readable(uart_inst_t *uart);
+bool uart_is_writable(uart_inst_t *uart);
+char uart_getc(uart_inst_t *uart);
+void uart_putc_raw(uart_inst_t *uart, char c);
+void uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len);
+
+/**
+ * @brief Write to the pty
+ *
+ * Blocks for the time the frame would take on the wire at the configured
+ * baudrate (10 bits per byte), unless wire timing is disabled.
+ */
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len);
+void uart_tx_wait_blocking(uart_inst_t *uart);
+
+
+#endif // !__HOST_HARDWARE_UART_H
@@ -0,0 +1,25 @@
+#ifndef __HOST_HARDWARE_VREG_H
+#define __HOST_HARDWARE_VREG_H
+
+#include "pico.h"
+
+
+enum vreg_voltage {
+    VREG_VOLTAGE_0_85 = 0b0110,
+    VREG_VOLTAGE_0_90 = 0b0111,
+    VREG_VOLTAGE_0_95 = 0b1000,
+    VREG_VOLTAGE_1_00 = 0b1001,
+    VREG_VOLTAGE_1_05 = 0b1010,
+    VREG_VOLTAGE_1_10 = 0b1011,
+    VREG_VOLTAGE_1_15 = 0b1100,
+    VREG_VOLTAGE_1_20 = 0b1101,
+    VREG_VOLTAGE_1_25 = 0b1110,
+    VREG_VOLTAGE_1_30 = 0b1111,
+    VREG_VOLTAGE_DEFAULT = VREG_VOLTAGE_1_10,
+};
+
+
+void vreg_set_voltage(enum vreg_voltage voltage);
+
+
+#endif // !__HOST_HARDWARE_VREG_H
@@ -0,0 +1,17 @@
+#ifndef __HOST_HARDWARE_WATCHDOG_H
+#define __HOST_HARDWARE_WATCHDOG_H
+
+#include "pico.h"
+
+
+/// @brief Watchdog is not simulated, the host scheduler cannot guarantee its deadlines
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_update(void);
+bool watchdog_caused_reboot(void);
+bool watchdog_enable_caused_reboot(void);
+
+/// @brief Reboot the chip, terminates the host process
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
+
+
+#endif // !__HOST_HARDWARE_WATCHDOG_H
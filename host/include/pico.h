@@ -0,0 +1,17 @@
+#ifndef __HOST_PICO_H
+#define __HOST_PICO_H
+
+/**
+ * @file pico.h
+ * @brief Host stand-in for the pico-sdk base header
+ *
+ * Pulls in the basic types and the board configuration, the same way the
+ * pico-sdk does through pico/config.h.
+ */
+
+#include "pico/types.h"
+#include "pico/config.h"
+#include <assert.h>  // pico/assert.h in pico-sdk
+
+
+#endif // !__HOST_PICO_H
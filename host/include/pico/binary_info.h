@@ -0,0 +1,11 @@
+#ifndef __HOST_PICO_BINARY_INFO_H
+#define __HOST_PICO_BINARY_INFO_H
+
+// picotool metadata has no meaning on host
+#define bi_decl(...)
+#define bi_2pins_with_func(...)
+#define bi_1pin_with_name(...)
+#define bi_program_description(...)
+
+
+#endif // !__HOST_PICO_BINARY_INFO_H
@@ -0,0 +1,8 @@
+#ifndef __HOST_PICO_CONFIG_H
+#define __HOST_PICO_CONFIG_H
+
+// board header, PICO_BOARD_HEADER_DIRS is on the include path of the host build
+#include "xerxes_rp2040.h"
+
+
+#endif // !__HOST_PICO_CONFIG_H
@@ -0,0 +1,25 @@
+#ifndef __HOST_PICO_CRITICAL_SECTION_H
+#define __HOST_PICO_CRITICAL_SECTION_H
+
+#include "pico.h"
+#include <mutex>
+
+
+/**
+ * @brief Lock shared by both cores, host stand-in for pico_sync critical_section
+ *
+ * The spin lock with interrupts disabled of the pico-sdk is replaced by a
+ * std::mutex. Same as in the pico-sdk the section is not recursive.
+ */
+typedef struct {
+    std::mutex lock;
+} critical_section_t;
+
+
+void critical_section_init(critical_section_t *crit_sec);
+void critical_section_enter_blocking(critical_section_t *crit_sec);
+void critical_section_exit(critical_section_t *crit_sec);
+void critical_section_deinit(critical_section_t *crit_sec);
+
+
+#endif // !__HOST_PICO_CRITICAL_SECTION_H
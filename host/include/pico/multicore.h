@@ -0,0 +1,43 @@
+#ifndef __HOST_PICO_MULTICORE_H
+#define __HOST_PICO_MULTICORE_H
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/sync.h"  // pulled in through pico/sync.h in pico-sdk
+
+
+/**
+ * @brief Run entry on "core1", a detached std::thread on the host
+ *
+ * @param entry function to run, should never return
+ */
+void multicore_launch_core1(void (*entry)(void));
+
+/// @brief Mark the calling thread as lockout victim
+void multicore_lockout_victim_init(void);
+
+/**
+ * @brief Request core1 to pause
+ *
+ * A thread cannot be parked preemptively on the host, so the lockout only
+ * serialises with save_and_disable_interrupts() and always succeeds.
+ *
+ * @param timeout_us ignored
+ * @return true always
+ */
+bool multicore_lockout_start_timeout_us(uint64_t timeout_us);
+
+/// @brief Release core1, see multicore_lockout_start_timeout_us()
+bool multicore_lockout_end_timeout_us(uint64_t timeout_us);
+
+/// @brief Blocking variant of multicore_lockout_start_timeout_us()
+void multicore_lockout_start_blocking(void);
+
+/// @brief Blocking variant of multicore_lockout_end_timeout_us()
+void multicore_lockout_end_blocking(void);
+
+/// @brief Index of the calling core, 0 for the main thread, 1 for core1 thread
+uint get_core_num(void);
+
+
+#endif // !__HOST_PICO_MULTICORE_H
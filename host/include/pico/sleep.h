@@ -0,0 +1,9 @@
+#ifndef __HOST_PICO_SLEEP_H
+#define __HOST_PICO_SLEEP_H
+
+#include "pico.h"
+
+// pico-extras low power sleep is not simulated, dormant modes are a no-op on host
+
+
+#endif // !__HOST_PICO_SLEEP_H
@@ -0,0 +1,22 @@
+#ifndef __HOST_PICO_STDLIB_H
+#define __HOST_PICO_STDLIB_H
+
+#include <assert.h>
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/uart.h"
+
+
+/// @brief Initialise all stdio drivers, stdout of the host process is always available
+bool stdio_init_all(void);
+
+/// @brief Initialise the USB stdio driver, no-op on host
+bool stdio_usb_init(void);
+
+/// @brief USB is reported as connected, stdout is used instead
+bool stdio_usb_connected(void);
+
+
+#endif // !__HOST_PICO_STDLIB_H
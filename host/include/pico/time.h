@@ -0,0 +1,80 @@
+#ifndef __HOST_PICO_TIME_H
+#define __HOST_PICO_TIME_H
+
+#include "pico.h"
+
+
+/// @brief Microseconds since the start of the simulation (or virtual time, see HostHal.hpp)
+uint64_t time_us_64(void);
+
+/// @brief Lower 32 bits of time_us_64()
+uint32_t time_us_32(void);
+
+/// @brief Sleep for the given amount of microseconds
+void sleep_us(uint64_t us);
+
+/// @brief Sleep for the given amount of milliseconds
+void sleep_ms(uint32_t ms);
+
+/// @brief Busy wait for the given amount of microseconds
+void busy_wait_us(uint64_t us);
+
+/// @brief Busy wait for the given amount of microseconds
+void busy_wait_us_32(uint32_t us);
+
+
+static inline uint64_t to_us_since_boot(absolute_time_t t)
+{
+#ifdef NDEBUG
+    return t;
+#else
+    return t._private_us_since_boot;
+#endif // NDEBUG
+}
+
+
+static inline void update_us_since_boot(absolute_time_t *t, uint64_t us)
+{
+#ifdef NDEBUG
+    *t = us;
+#else
+    t->_private_us_since_boot = us;
+#endif // NDEBUG
+}
+
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    absolute_time_t t;
+    update_us_since_boot(&t, time_us_64());
+    return t;
+}
+
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us)
+{
+    absolute_time_t t;
+    update_us_since_boot(&t, time_us_64() + us);
+    return t;
+}
+
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return make_timeout_time_us(ms * 1000ull);
+}
+
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t)(to_us_since_boot(to) - to_us_since_boot(from));
+}
+
+
+static inline bool time_reached(absolute_time_t t)
+{
+    return time_us_64() >= to_us_since_boot(t);
+}
+
+
+#endif // !__HOST_PICO_TIME_H
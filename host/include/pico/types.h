@@ -0,0 +1,35 @@
+#ifndef __HOST_PICO_TYPES_H
+#define __HOST_PICO_TYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+typedef unsigned int uint;
+
+/**
+ * @brief Absolute time in microseconds since boot
+ *
+ * Same as in pico-sdk: opaque struct in debug builds, plain integer in release.
+ */
+#ifdef NDEBUG
+typedef uint64_t absolute_time_t;
+#else
+typedef struct {
+    uint64_t _private_us_since_boot;
+} absolute_time_t;
+#endif // NDEBUG
+
+
+/// @brief Error codes returned by blocking bus functions
+enum pico_error_codes {
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+    PICO_ERROR_NO_DATA = -3,
+};
+
+
+#endif // !__HOST_PICO_TYPES_H
@@ -0,0 +1,51 @@
+#ifndef __HOST_PICO_UTIL_QUEUE_H
+#define __HOST_PICO_UTIL_QUEUE_H
+
+#include "pico.h"
+#include "pico/time.h"       // pulled in through pico/lock_core.h in pico-sdk
+#include "hardware/sync.h"  // pulled in through pico/lock_core.h in pico-sdk
+#include <mutex>
+
+
+/**
+ * @brief Multi-core and IRQ safe queue, host stand-in for pico_util queue
+ *
+ * The spin lock of the pico-sdk is replaced by a std::mutex, semantics of the
+ * element copy and of the one-slot-free ring are the same as in the pico-sdk.
+ */
+typedef struct {
+    std::mutex lock;
+    uint8_t *data = nullptr;
+    uint16_t wptr = 0;
+    uint16_t rptr = 0;
+    uint16_t element_size = 0;
+    uint16_t element_count = 0;
+} queue_t;
+
+
+void queue_init(queue_t *q, uint element_size, uint element_count);
+void queue_free(queue_t *q);
+
+uint queue_get_level_unsafe(queue_t *q);
+uint queue_get_level(queue_t *q);
+
+static inline bool queue_is_empty(queue_t *q)
+{
+    return queue_get_level(q) == 0;
+}
+
+static inline bool queue_is_full(queue_t *q)
+{
+    return queue_get_level(q) == q->element_count;
+}
+
+bool queue_try_add(queue_t *q, const void *data);
+bool queue_try_remove(queue_t *q, void *data);
+bool queue_try_peek(queue_t *q, void *data);
+
+void queue_add_blocking(queue_t *q, const void *data);
+void queue_remove_blocking(queue_t *q, void *data);
+void queue_peek_blocking(queue_t *q, void *data);
+
+
+#endif // !__HOST_PICO_UTIL_QUEUE_H
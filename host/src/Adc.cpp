@@ -0,0 +1,116 @@
+#include "hardware/adc.h"
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+#include "hardware/gpio.h"
+#include "pico/time.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+constexpr uint numInputs = 5;
+constexpr uint tempSensorInput = 4;
+constexpr double vRef = 3.3;
+constexpr double tempSensorVolts = 0.706;  // 27°C
+
+struct Adc
+{
+    std::mutex lock;
+    Signal inputs[numInputs];
+    uint selected = 0;
+};
+
+
+Adc &adc()
+{
+    static Adc instance;
+    return instance;
+}
+
+} // namespace
+
+
+void setAdcSignal(uint channel, Signal volts)
+{
+    std::lock_guard<std::mutex> guard(adc().lock);
+    adc().inputs[channel] = volts;
+}
+
+
+void resetAdc()
+{
+    std::lock_guard<std::mutex> guard(adc().lock);
+    for(auto &input : adc().inputs)
+    {
+        input = nullptr;
+    }
+    adc().selected = 0;
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+void adc_init(void)
+{
+}
+
+
+void adc_gpio_init(uint gpio)
+{
+    gpio_set_function(gpio, GPIO_FUNC_NULL);
+    gpio_disable_pulls(gpio);
+}
+
+
+void adc_select_input(uint input)
+{
+    std::lock_guard<std::mutex> guard(adc().lock);
+    adc().selected = input;
+}
+
+
+uint adc_get_selected_input(void)
+{
+    std::lock_guard<std::mutex> guard(adc().lock);
+    return adc().selected;
+}
+
+
+void adc_set_temp_sensor_enabled(bool enable)
+{
+    (void)enable;
+}
+
+
+uint16_t adc_read(void)
+{
+    std::lock_guard<std::mutex> guard(adc().lock);
+    const auto &input = adc().inputs[adc().selected];
+
+    double volts = 0;
+    if(input)
+    {
+        volts = input(time_us_64());
+    }
+    else if(adc().selected == tempSensorInput)
+    {
+        volts = tempSensorVolts;
+    }
+
+    double code = std::round(volts / vRef * 4096);
+    return static_cast<uint16_t>(std::clamp(code, 0.0, 4095.0));
+}
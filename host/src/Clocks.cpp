@@ -0,0 +1,196 @@
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+#include "hardware/vreg.h"
+#include "hardware/rtc.h"
+#include "hardware/watchdog.h"
+#include "pico/stdlib.h"
+#include "HostInternal.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+
+pll_hw_t host_pll_inst[2] = {{0}, {1}};
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+std::atomic<uint32_t> clockHz[CLK_COUNT];
+std::atomic<uint32_t> pllHz[2];
+std::atomic<uint32_t> roscHz {6'500'000};
+
+
+/// @brief frequencies after the pico-sdk runtime init
+void powerOnState()
+{
+    for(auto &el : clockHz) el = 0;
+    clockHz[clk_ref] = 12 * MHZ;
+    clockHz[clk_sys] = 125 * MHZ;
+    clockHz[clk_peri] = 125 * MHZ;
+    clockHz[clk_usb] = 48 * MHZ;
+    clockHz[clk_adc] = 48 * MHZ;
+    clockHz[clk_rtc] = 46875;
+    pllHz[0] = 125 * MHZ;
+    pllHz[1] = 48 * MHZ;
+}
+
+
+struct PowerOn
+{
+    PowerOn() { powerOnState(); }
+} powerOn;
+
+} // namespace
+
+
+void resetClocks()
+{
+    powerOnState();
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq)
+{
+    (void)src;
+    (void)auxsrc;
+    if(freq > src_freq)
+    {
+        return false;
+    }
+    clockHz[clk_index] = freq;
+    return true;
+}
+
+
+void clock_stop(enum clock_index clk_index)
+{
+    clockHz[clk_index] = 0;
+}
+
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    return clockHz[clk_index];
+}
+
+
+uint32_t frequency_count_khz(uint src)
+{
+    switch(src)
+    {
+    case CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY:
+        return pllHz[0] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY:
+        return pllHz[1] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC:
+        return roscHz / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_CLK_REF:
+        return clockHz[clk_ref] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_CLK_SYS:
+        return clockHz[clk_sys] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_CLK_PERI:
+        return clockHz[clk_peri] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_CLK_USB:
+        return clockHz[clk_usb] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_CLK_ADC:
+        return clockHz[clk_adc] / KHZ;
+    case CLOCKS_FC0_SRC_VALUE_CLK_RTC:
+        return clockHz[clk_rtc] / KHZ;
+    default:
+        return 0;
+    }
+}
+
+
+void pll_init(PLL pll, uint ref_div, uint vco_freq, uint post_div1, uint post_div2)
+{
+    (void)ref_div;
+    pllHz[pll->index] = vco_freq / (post_div1 * post_div2);
+}
+
+
+void pll_deinit(PLL pll)
+{
+    pllHz[pll->index] = 0;
+}
+
+
+void vreg_set_voltage(enum vreg_voltage voltage)
+{
+    (void)voltage;
+}
+
+
+void rtc_init(void)
+{
+}
+
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug)
+{
+    (void)delay_ms;
+    (void)pause_on_debug;
+}
+
+
+void watchdog_update(void)
+{
+}
+
+
+bool watchdog_caused_reboot(void)
+{
+    return false;
+}
+
+
+bool watchdog_enable_caused_reboot(void)
+{
+    return false;
+}
+
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms)
+{
+    (void)pc;
+    (void)sp;
+    (void)delay_ms;
+
+    // core1 thread is still running, skip static destructors
+    std::fflush(stdout);
+    std::fflush(stderr);
+    std::_Exit(EXIT_SUCCESS);
+}
+
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+
+bool stdio_usb_init(void)
+{
+    return true;
+}
+
+
+bool stdio_usb_connected(void)
+{
+    return true;
+}
@@ -0,0 +1,25 @@
+#include "pico/critical_section.h"
+
+
+void critical_section_init(critical_section_t *crit_sec)
+{
+    (void)crit_sec;
+}
+
+
+void critical_section_enter_blocking(critical_section_t *crit_sec)
+{
+    crit_sec->lock.lock();
+}
+
+
+void critical_section_exit(critical_section_t *crit_sec)
+{
+    crit_sec->lock.unlock();
+}
+
+
+void critical_section_deinit(critical_section_t *crit_sec)
+{
+    (void)crit_sec;
+}
@@ -0,0 +1,85 @@
+#include "Devices/AbpModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "pico/time.h"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+constexpr double countsMin = 1638;   // 10% of 2^14
+constexpr double countsMax = 14745;  // 90% of 2^14
+
+} // namespace
+
+
+AbpModel::AbpModel(double pMin, double pMax) : pMin(pMin), pMax(pMax)
+{
+    pressure = constant(pMin);
+    temperature = constant(25);
+}
+
+
+void AbpModel::setPressure(Signal pascal)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    pressure = pascal;
+}
+
+
+void AbpModel::setTemperature(Signal celsius)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    temperature = celsius;
+}
+
+
+void AbpModel::select(bool selected)
+{
+    (void)selected;
+    std::lock_guard<std::mutex> guard(lock);
+    position = 0;
+}
+
+
+void AbpModel::sample()
+{
+    // status bits 00 = normal operation
+    const uint64_t now = time_us_64();
+
+    double counts = (pressure(now) - pMin) / (pMax - pMin) * (countsMax - countsMin) + countsMin;
+    auto p = static_cast<uint16_t>(std::clamp(std::round(counts), 0.0, 16383.0));
+    auto t = static_cast<uint16_t>(std::clamp(std::round((temperature(now) + 50) * 2047 / 200), 0.0, 2047.0));
+
+    data[0] = static_cast<uint8_t>(p >> 8);
+    data[1] = static_cast<uint8_t>(p);
+    data[2] = static_cast<uint8_t>(t >> 3);
+    data[3] = static_cast<uint8_t>(t << 5);
+}
+
+
+void AbpModel::transfer(const uint8_t *tx, uint8_t *rx, size_t len)
+{
+    (void)tx;
+    std::lock_guard<std::mutex> guard(lock);
+    if(position == 0)
+    {
+        sample();
+    }
+
+    for(size_t i = 0; i < len; i++, position++)
+    {
+        rx[i] = position < sizeof(data) ? data[position] : 0xFF;
+    }
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
@@ -0,0 +1,116 @@
+#include "Devices/Ads1115Model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "pico/time.h"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+constexpr uint8_t REG_CONVERSION = 0;
+constexpr uint8_t REG_CONFIG = 1;
+constexpr uint16_t OS = 0x8000;
+
+constexpr double fullScale[8] = {6.144, 4.096, 2.048, 1.024, 0.512, 0.256, 0.256, 0.256};
+
+} // namespace
+
+
+Ads1115Model::Ads1115Model()
+{
+    for(auto &input : inputs)
+    {
+        input = constant(0);
+    }
+}
+
+
+void Ads1115Model::setInput(uint channel, Signal volts)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    inputs[channel] = volts;
+}
+
+
+int16_t Ads1115Model::convert()
+{
+    const uint64_t now = time_us_64();
+    const uint mux = (config >> 12) & 0x7;
+
+    double volts;
+    switch(mux)
+    {
+    case 0: volts = inputs[0](now) - inputs[1](now); break;
+    case 1: volts = inputs[0](now) - inputs[3](now); break;
+    case 2: volts = inputs[1](now) - inputs[3](now); break;
+    case 3: volts = inputs[2](now) - inputs[3](now); break;
+    default: volts = inputs[mux - 4](now); break;
+    }
+
+    double fs = fullScale[(config >> 9) & 0x7];
+    return static_cast<int16_t>(std::clamp(std::round(volts / fs * 32768), -32768.0, 32767.0));
+}
+
+
+int Ads1115Model::write(const uint8_t *src, size_t len, bool nostop)
+{
+    (void)nostop;
+    std::lock_guard<std::mutex> guard(lock);
+    if(len == 0)
+    {
+        return 0;
+    }
+
+    pointer = src[0] & 0x3;
+    if(len >= 3)
+    {
+        uint16_t value = static_cast<uint16_t>((src[1] << 8) | src[2]);
+        if(pointer == REG_CONFIG)
+        {
+            config = value;
+            if(config & OS)
+            {
+                // start conversion, done before the master can poll OS
+                conversion = convert();
+            }
+            config |= OS;
+        }
+        else if(pointer != REG_CONVERSION)
+        {
+            thresholds[pointer - 2] = value;
+        }
+    }
+    return static_cast<int>(len);
+}
+
+
+int Ads1115Model::read(uint8_t *dst, size_t len, bool nostop)
+{
+    (void)nostop;
+    std::lock_guard<std::mutex> guard(lock);
+
+    uint16_t value;
+    switch(pointer)
+    {
+    case REG_CONVERSION: value = static_cast<uint16_t>(conversion); break;
+    case REG_CONFIG: value = config; break;
+    default: value = thresholds[pointer - 2]; break;
+    }
+
+    for(size_t i = 0; i < len; i++)
+    {
+        dst[i] = i == 0 ? static_cast<uint8_t>(value >> 8) : static_cast<uint8_t>(value);
+    }
+    return static_cast<int>(len);
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
@@ -0,0 +1,70 @@
+#include "Devices/Hx711Model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "pico/time.h"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+Hx711Model::Hx711Model(uint sckPin, uint doutPin) : sckPin(sckPin), doutPin(doutPin)
+{
+    counts = constant(0);
+}
+
+
+void Hx711Model::setInput(Signal value)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    counts = value;
+}
+
+
+void Hx711Model::output(uint gpio, bool level)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if(gpio != sckPin)
+    {
+        return;
+    }
+
+    bool rising = level && !sck;
+    sck = level;
+    if(!rising)
+    {
+        return;
+    }
+
+    if(pulses == 0)
+    {
+        double value = std::clamp(std::round(counts(time_us_64())), -8388608.0, 8388607.0);
+        shift = static_cast<uint32_t>(static_cast<int32_t>(value)) & 0xFFFFFF;
+    }
+
+    pulses++;
+    if(pulses <= 24)
+    {
+        dout = (shift >> (24 - pulses)) & 1;
+    }
+    else
+    {
+        // 25th pulse selects channel A gain 128, next conversion is ready right away
+        dout = false;
+        pulses = 0;
+    }
+}
+
+
+bool Hx711Model::input(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return gpio == doutPin ? dout : false;
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
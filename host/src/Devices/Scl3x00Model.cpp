@@ -0,0 +1,179 @@
+#include "Devices/Scl3x00Model.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include "pico/time.h"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+// register addresses, bits 30:26 of the command
+constexpr uint8_t ADDR_ACC_X = 0x01;
+constexpr uint8_t ADDR_ACC_Y = 0x02;
+constexpr uint8_t ADDR_ACC_Z = 0x03;
+constexpr uint8_t ADDR_TEMP = 0x05;
+constexpr uint8_t ADDR_STATUS = 0x06;
+constexpr uint8_t ADDR_ANG_X = 0x09;
+constexpr uint8_t ADDR_ANG_Y = 0x0A;
+constexpr uint8_t ADDR_ANG_Z = 0x0B;
+constexpr uint8_t ADDR_MODE = 0x0D;
+constexpr uint8_t ADDR_WHOAMI = 0x10;
+
+constexpr uint8_t RS_NORMAL = 0b01;
+constexpr uint16_t WHOAMI = 0x00C1;
+
+
+uint8_t crc8(uint32_t data)
+{
+    uint8_t crc = 0xFF;
+    for(int bit = 31; bit > 7; bit--)
+    {
+        bool msb = crc & 0x80;
+        crc <<= 1;
+        if(msb != static_cast<bool>((data >> bit) & 1))
+        {
+            crc ^= 0x1D;
+        }
+    }
+    return static_cast<uint8_t>(~crc);
+}
+
+
+int16_t saturate(double value)
+{
+    return static_cast<int16_t>(std::clamp(std::round(value), -32768.0, 32767.0));
+}
+
+} // namespace
+
+
+Scl3x00Model::Scl3x00Model(const std::array<double, 4> &sensitivity) : sensitivity(sensitivity)
+{
+    for(auto &axis : angle)
+    {
+        axis = constant(0);
+    }
+    temperature = constant(25);
+}
+
+
+Scl3x00Model Scl3x00Model::scl3300()
+{
+    return Scl3x00Model({6000, 3000, 12000, 12000});
+}
+
+
+Scl3x00Model Scl3x00Model::scl3400()
+{
+    return Scl3x00Model({32768, 32768, 32768, 32768});
+}
+
+
+void Scl3x00Model::setAngle(uint axis, Signal degrees)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    angle[axis] = degrees;
+}
+
+
+void Scl3x00Model::setTemperature(Signal celsius)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    temperature = celsius;
+}
+
+
+void Scl3x00Model::select(bool selected)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if(selected)
+    {
+        position = 0;
+        shiftIn = 0;
+    }
+    else if(position == 4)
+    {
+        // frame complete, prepare reply for the next one
+        nextReply = reply(shiftIn);
+    }
+}
+
+
+void Scl3x00Model::transfer(const uint8_t *tx, uint8_t *rx, size_t len)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for(size_t i = 0; i < len; i++, position++)
+    {
+        if(position < 4)
+        {
+            rx[i] = static_cast<uint8_t>(nextReply >> (8 * (3 - position)));
+            shiftIn = (shiftIn << 8) | tx[i];
+        }
+        else
+        {
+            rx[i] = 0xFF;
+        }
+    }
+}
+
+
+uint32_t Scl3x00Model::frame(uint8_t address, uint16_t data) const
+{
+    uint32_t word = (static_cast<uint32_t>(address & 0x1F) << 26) | (RS_NORMAL << 24) | (static_cast<uint32_t>(data) << 8);
+    return word | crc8(word);
+}
+
+
+uint32_t Scl3x00Model::reply(uint32_t command)
+{
+    const bool write = command >> 31;
+    const uint8_t address = (command >> 26) & 0x1F;
+    const uint16_t data = (command >> 8) & 0xFFFF;
+    const uint64_t now = time_us_64();
+
+    if(write)
+    {
+        if(address == ADDR_MODE && data < 4)
+        {
+            mode = static_cast<uint8_t>(data);
+        }
+        return frame(address, data);
+    }
+
+    auto acc = [&](uint axis)
+    {
+        double g = std::sin(angle[axis](now) * M_PI / 180);
+        return static_cast<uint16_t>(saturate(g * sensitivity[mode]));
+    };
+    auto ang = [&](uint axis)
+    {
+        return static_cast<uint16_t>(saturate(angle[axis](now) / 180 * 32768));
+    };
+
+    switch(address)
+    {
+    case ADDR_ACC_X: return frame(address, acc(0));
+    case ADDR_ACC_Y: return frame(address, acc(1));
+    case ADDR_ACC_Z: return frame(address, acc(2));
+    case ADDR_ANG_X: return frame(address, ang(0));
+    case ADDR_ANG_Y: return frame(address, ang(1));
+    case ADDR_ANG_Z: return frame(address, ang(2));
+    case ADDR_TEMP:
+        return frame(address, static_cast<uint16_t>(std::round((temperature(now) + 273) * 18.9)));
+    case ADDR_STATUS: return frame(address, 0);
+    case ADDR_MODE: return frame(address, mode);
+    case ADDR_WHOAMI: return frame(address, WHOAMI);
+    default: return frame(address, 0);
+    }
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
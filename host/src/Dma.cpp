@@ -0,0 +1,373 @@
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "HostInternal.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace
+{
+
+struct Channel
+{
+    bool claimed = false;
+    bool busy = false;
+    dma_channel_config config {};
+    uint32_t reload = 0;        ///< count loaded on trigger
+    bool irq0Enabled = false;
+    bool irq0Status = false;
+};
+
+std::recursive_mutex lock;
+Channel channels[NUM_DMA_CHANNELS];
+dma_channel_hw_t hw[NUM_DMA_CHANNELS];
+
+
+uintptr_t advance(uintptr_t addr, bool increment, uint ringBits)
+{
+    if(!increment)
+    {
+        return addr;
+    }
+    if(ringBits == 0)
+    {
+        return addr + 1;
+    }
+
+    // upper bits stay, the buffer must be aligned to the ring size as on the chip
+    const uintptr_t mask = (uintptr_t(1) << ringBits) - 1;
+    return (addr & ~mask) | ((addr + 1) & mask);
+}
+
+
+/// @brief next byte of the channel, false if its DREQ is not ready
+bool readByte(const Channel &c, uintptr_t addr, uint8_t &byte)
+{
+    switch(c.config.dreq)
+    {
+    case DREQ_UART0_RX:
+        return Xerxes::Sim::uartDmaRead(0, byte);
+    case DREQ_UART1_RX:
+        return Xerxes::Sim::uartDmaRead(1, byte);
+    default:
+        byte = *reinterpret_cast<const volatile uint8_t *>(addr);
+        return true;
+    }
+}
+
+
+/// @brief byte to the destination of the channel, the TX FIFO of the UART is never full
+void writeByte(const Channel &c, uintptr_t addr, uint8_t byte)
+{
+    switch(c.config.dreq)
+    {
+    case DREQ_UART0_TX:
+        Xerxes::Sim::uartDmaWrite(0, byte);
+        break;
+    case DREQ_UART1_TX:
+        Xerxes::Sim::uartDmaWrite(1, byte);
+        break;
+    default:
+        *reinterpret_cast<volatile uint8_t *>(addr) = byte;
+    }
+}
+
+
+/**
+ * @brief Move bytes while the DREQ of the channel is ready, with the lock held
+ *
+ * @return true if the channel completed and DMA_IRQ_0 should fire
+ */
+bool run(uint ch)
+{
+    Channel &c = channels[ch];
+    dma_channel_hw_t &regs = hw[ch];
+
+    while(c.busy && regs.transfer_count > 0)
+    {
+        uint8_t byte;
+        if(!readByte(c, regs.read_addr, byte))
+        {
+            return false;
+        }
+        writeByte(c, regs.write_addr, byte);
+
+        const uint ringBits = c.config.ring_size_bits;
+        regs.read_addr = advance(regs.read_addr, c.config.read_increment, c.config.ring_write ? 0 : ringBits);
+        regs.write_addr = advance(regs.write_addr, c.config.write_increment, c.config.ring_write ? ringBits : 0);
+
+        // data is in memory before the count says so, the firmware polls the count from another thread
+        std::atomic_thread_fence(std::memory_order_release);
+        regs.transfer_count = regs.transfer_count - 1;
+    }
+
+    if(!c.busy)
+    {
+        return false;
+    }
+    c.busy = false;
+    c.irq0Status = true;
+    return c.irq0Enabled;
+}
+
+
+void triggerChannel(uint ch)
+{
+    bool irq;
+    {
+        std::lock_guard<std::recursive_mutex> guard(lock);
+        channels[ch].busy = true;
+        hw[ch].transfer_count = channels[ch].reload;
+        irq = run(ch);
+    }
+
+    // handler may retrigger the channel, it runs without the DMA lock
+    if(irq)
+    {
+        irq_set_pending(DMA_IRQ_0);
+    }
+}
+
+} // namespace
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+void dmaRequest(uint dreq)
+{
+    bool irq = false;
+    {
+        std::lock_guard<std::recursive_mutex> guard(lock);
+        for(uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+        {
+            if(channels[ch].busy && channels[ch].config.dreq == dreq)
+            {
+                irq |= run(ch);
+            }
+        }
+    }
+
+    if(irq)
+    {
+        irq_set_pending(DMA_IRQ_0);
+    }
+}
+
+
+void resetDma()
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    for(uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+    {
+        channels[ch] = Channel {};
+        hw[ch] = dma_channel_hw_t {};
+    }
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel)
+{
+    return &hw[channel];
+}
+
+
+void dma_channel_claim(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    if(channels[channel].claimed)
+    {
+        std::fprintf(stderr, "dma: channel %u is already claimed\n", channel);
+        std::abort();
+    }
+    channels[channel].claimed = true;
+}
+
+
+int dma_claim_unused_channel(bool required)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    for(uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+    {
+        if(!channels[ch].claimed)
+        {
+            channels[ch].claimed = true;
+            return ch;
+        }
+    }
+
+    if(required)
+    {
+        std::fprintf(stderr, "dma: no free channel\n");
+        std::abort();
+    }
+    return -1;
+}
+
+
+void dma_channel_unclaim(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    channels[channel].claimed = false;
+}
+
+
+bool dma_channel_is_claimed(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    return channels[channel].claimed;
+}
+
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    (void)channel;
+    dma_channel_config c {};
+    c.read_increment = true;
+    c.write_increment = false;
+    c.dreq = DREQ_FORCE;
+    c.size = DMA_SIZE_32;
+    return c;
+}
+
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    c->read_increment = incr;
+}
+
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    c->write_increment = incr;
+}
+
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+    c->dreq = dreq;
+}
+
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    c->size = size;
+}
+
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+    c->ring_write = write;
+    c->ring_size_bits = size_bits;
+}
+
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    assert(config->size == DMA_SIZE_8);
+    {
+        std::lock_guard<std::recursive_mutex> guard(lock);
+        channels[channel].config = *config;
+        channels[channel].reload = transfer_count;
+        hw[channel].write_addr = reinterpret_cast<uintptr_t>(write_addr);
+        hw[channel].read_addr = reinterpret_cast<uintptr_t>(read_addr);
+    }
+
+    if(trigger)
+    {
+        triggerChannel(channel);
+    }
+}
+
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+    {
+        std::lock_guard<std::recursive_mutex> guard(lock);
+        hw[channel].read_addr = reinterpret_cast<uintptr_t>(read_addr);
+    }
+
+    if(trigger)
+    {
+        triggerChannel(channel);
+    }
+}
+
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger)
+{
+    {
+        std::lock_guard<std::recursive_mutex> guard(lock);
+        hw[channel].write_addr = reinterpret_cast<uintptr_t>(write_addr);
+    }
+
+    if(trigger)
+    {
+        triggerChannel(channel);
+    }
+}
+
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger)
+{
+    {
+        std::lock_guard<std::recursive_mutex> guard(lock);
+        channels[channel].reload = trans_count;
+    }
+
+    if(trigger)
+    {
+        triggerChannel(channel);
+    }
+}
+
+
+void dma_channel_start(uint channel)
+{
+    triggerChannel(channel);
+}
+
+
+void dma_channel_abort(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    channels[channel].busy = false;
+}
+
+
+bool dma_channel_is_busy(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    return channels[channel].busy;
+}
+
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    channels[channel].irq0Enabled = enabled;
+}
+
+
+bool dma_channel_get_irq0_status(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    return channels[channel].irq0Status;
+}
+
+
+void dma_channel_acknowledge_irq0(uint channel)
+{
+    std::lock_guard<std::recursive_mutex> guard(lock);
+    channels[channel].irq0Status = false;
+}
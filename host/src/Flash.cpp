@@ -0,0 +1,126 @@
+#include "hardware/flash.h"
+#include "HostInternal.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+uint8_t host_flash_image[PICO_FLASH_SIZE_BYTES];
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+/**
+ * @brief Backing file of the flash image, XERXES_HOST_FLASH
+ *
+ * Keeps the configuration across restarts of the simulated device
+ * (e.g. after a soft reset), the image is erased if not set.
+ */
+FILE *backingFile()
+{
+    static FILE *file = []() -> FILE *
+    {
+        const char *path = std::getenv("XERXES_HOST_FLASH");
+        if(!path) return nullptr;
+
+        FILE *f = std::fopen(path, "r+b");
+        if(!f) f = std::fopen(path, "w+b");
+        if(!f) std::perror("flash: cannot open backing file");
+        return f;
+    }();
+    return file;
+}
+
+
+void persist(uint32_t offset, size_t count)
+{
+    FILE *file = backingFile();
+    if(file)
+    {
+        std::fseek(file, offset, SEEK_SET);
+        std::fwrite(host_flash_image + offset, 1, count, file);
+        std::fflush(file);
+    }
+}
+
+
+struct PowerOn
+{
+    PowerOn()
+    {
+        std::memset(host_flash_image, 0xFF, sizeof(host_flash_image));
+
+        FILE *file = backingFile();
+        if(file)
+        {
+            std::fseek(file, 0, SEEK_SET);
+            size_t len = std::fread(host_flash_image, 1, sizeof(host_flash_image), file);
+            (void)len;
+        }
+    }
+};
+
+// before any other static initialiser may read the memory mapped flash
+__attribute__((init_priority(101))) PowerOn powerOn;
+
+} // namespace
+
+
+void resetFlash()
+{
+    std::memset(host_flash_image, 0xFF, sizeof(host_flash_image));
+    persist(0, sizeof(host_flash_image));
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    assert(flash_offs % FLASH_SECTOR_SIZE == 0);
+    assert(flash_offs + count <= PICO_FLASH_SIZE_BYTES);
+
+    // whole sectors are erased, count is rounded up as by the boot rom
+    size_t sectors = (count + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE;
+    std::memset(host_flash_image + flash_offs, 0xFF, sectors * FLASH_SECTOR_SIZE);
+    Xerxes::Sim::persist(flash_offs, sectors * FLASH_SECTOR_SIZE);
+}
+
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    assert(flash_offs % FLASH_PAGE_SIZE == 0);
+    assert(count % FLASH_PAGE_SIZE == 0);
+    assert(flash_offs + count <= PICO_FLASH_SIZE_BYTES);
+
+    // programming can only clear bits, same as NOR flash
+    for(size_t i = 0; i < count; i++)
+    {
+        host_flash_image[flash_offs + i] &= data[i];
+    }
+    Xerxes::Sim::persist(flash_offs, count);
+}
+
+
+void flash_get_unique_id(uint8_t *id_out)
+{
+    const char *env = std::getenv("XERXES_HOST_UID");
+    uint64_t uid = env ? std::strtoull(env, nullptr, 0) : 0xE6605838833C2B2Full;
+
+    // chip returns the ID MSB first
+    for(int i = 0; i < FLASH_UNIQUE_ID_SIZE_BYTES; i++)
+    {
+        id_out[i] = static_cast<uint8_t>(uid >> (8 * (FLASH_UNIQUE_ID_SIZE_BYTES - 1 - i)));
+    }
+}
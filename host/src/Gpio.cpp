@@ -0,0 +1,395 @@
+#include "hardware/gpio.h"
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+#include "pico/time.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+enum class Pull : uint8_t
+{
+    NONE,
+    UP,
+    DOWN
+};
+
+struct Pin
+{
+    gpio_function function = GPIO_FUNC_NULL;
+    bool out = false;
+    bool latch = false;
+    Pull pull = Pull::DOWN;  // RP2040 pads are pulled down after reset
+    Signal signal;
+    GpioDevice *device = nullptr;
+    uint32_t irqEvents = 0;
+    bool lastLevel = false;
+};
+
+/// @brief interval of the edge detection on signal driven inputs
+constexpr auto irqPollInterval = std::chrono::microseconds(20);
+
+struct Bank
+{
+    std::mutex lock;
+    Pin pins[NUM_BANK0_GPIOS];
+
+    Bank() { powerOnState(); }
+
+    void powerOnState()
+    {
+        for(auto &pin : pins)
+        {
+            pin = Pin();
+        }
+
+        // user switch selects USB stdio when open (pulled up), host defaults to RS485 over pty
+        if(!std::getenv("XERXES_HOST_USB"))
+        {
+            pins[USR_SW_PIN].signal = constant(0);
+        }
+    }
+};
+
+std::atomic<gpio_irq_callback_t> irqCallback {nullptr};
+std::once_flag pollerStarted;
+
+
+/// @brief pin bank, constructed on first use so devices can be attached from static initialisers
+Bank &bank()
+{
+    static Bank instance;
+    return instance;
+}
+
+
+/// @brief level of the pin, lock must be held
+bool level(uint gpio)
+{
+    const Pin &pin = bank().pins[gpio];
+    if(pin.out)
+    {
+        return pin.latch;
+    }
+    if(pin.device)
+    {
+        return pin.device->input(gpio);
+    }
+    if(pin.signal)
+    {
+        return pin.signal(time_us_64()) > 0.5;
+    }
+    return pin.pull == Pull::UP;
+}
+
+
+void fireIrq(uint gpio, uint32_t events)
+{
+    gpio_irq_callback_t callback = irqCallback;
+    if(callback && irq_is_enabled(IO_IRQ_BANK0))
+    {
+        std::lock_guard<std::recursive_mutex> guard(irqLock());
+        callback(gpio, events);
+    }
+}
+
+
+/// @brief detect edges and levels on inputs with enabled IRQ, runs forever
+void pollIrqs()
+{
+    while(true)
+    {
+        std::this_thread::sleep_for(irqPollInterval);
+
+        uint32_t fired[NUM_BANK0_GPIOS] {};
+        {
+            std::lock_guard<std::mutex> guard(bank().lock);
+            for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+            {
+                Pin &pin = bank().pins[gpio];
+                if(!pin.irqEvents)
+                {
+                    continue;
+                }
+
+                bool now = level(gpio);
+                uint32_t events = now ? GPIO_IRQ_LEVEL_HIGH : GPIO_IRQ_LEVEL_LOW;
+                if(now && !pin.lastLevel) events |= GPIO_IRQ_EDGE_RISE;
+                if(!now && pin.lastLevel) events |= GPIO_IRQ_EDGE_FALL;
+                pin.lastLevel = now;
+
+                fired[gpio] = events & pin.irqEvents;
+            }
+        }
+
+        for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+        {
+            if(fired[gpio])
+            {
+                fireIrq(gpio, fired[gpio]);
+            }
+        }
+    }
+}
+
+} // namespace
+
+
+bool gpioDrivenLow(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    return bank().pins[gpio].out && !bank().pins[gpio].latch;
+}
+
+
+void resetGpio()
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().powerOnState();
+    irqCallback = nullptr;
+}
+
+
+void setGpioSignal(uint gpio, Signal signal)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].signal = signal;
+}
+
+
+void attachGpioDevice(uint gpio, GpioDevice *device)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].device = device;
+}
+
+
+void triggerGpioIrq(uint gpio, uint32_t events)
+{
+    uint32_t enabled;
+    {
+        std::lock_guard<std::mutex> guard(bank().lock);
+        enabled = bank().pins[gpio].irqEvents;
+    }
+
+    if(events & enabled)
+    {
+        fireIrq(gpio, events & enabled);
+    }
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+void gpio_init(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].out = false;
+    bank().pins[gpio].latch = false;
+    bank().pins[gpio].function = GPIO_FUNC_SIO;
+}
+
+
+void gpio_init_mask(uint gpio_mask)
+{
+    for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+    {
+        if(gpio_mask & (1u << gpio))
+        {
+            gpio_init(gpio);
+        }
+    }
+}
+
+
+void gpio_deinit(uint gpio)
+{
+    gpio_set_function(gpio, GPIO_FUNC_NULL);
+}
+
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].function = fn;
+}
+
+
+enum gpio_function gpio_get_function(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    return bank().pins[gpio].function;
+}
+
+
+void gpio_set_dir(uint gpio, bool out)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].out = out;
+}
+
+
+void gpio_set_dir_masked(uint32_t mask, uint32_t value)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+    {
+        if(mask & (1u << gpio))
+        {
+            bank().pins[gpio].out = value & (1u << gpio);
+        }
+    }
+}
+
+
+void gpio_set_dir_in_masked(uint32_t mask)
+{
+    gpio_set_dir_masked(mask, 0);
+}
+
+
+void gpio_set_dir_out_masked(uint32_t mask)
+{
+    gpio_set_dir_masked(mask, mask);
+}
+
+
+bool gpio_is_dir_out(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    return bank().pins[gpio].out;
+}
+
+
+void gpio_pull_up(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].pull = Pull::UP;
+}
+
+
+void gpio_pull_down(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].pull = Pull::DOWN;
+}
+
+
+void gpio_disable_pulls(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    bank().pins[gpio].pull = Pull::NONE;
+}
+
+
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive)
+{
+    (void)gpio;
+    (void)drive;
+}
+
+
+void gpio_put(uint gpio, bool value)
+{
+    GpioDevice *device;
+    bool edge;
+    {
+        std::lock_guard<std::mutex> guard(bank().lock);
+        edge = bank().pins[gpio].latch != value;
+        bank().pins[gpio].latch = value;
+        device = bank().pins[gpio].out ? bank().pins[gpio].device : nullptr;
+    }
+
+    // notify outside of the lock, devices may read other pins
+    if(device)
+    {
+        device->output(gpio, value);
+    }
+    if(edge)
+    {
+        spiChipSelect(gpio, value);
+    }
+}
+
+
+void gpio_put_masked(uint32_t mask, uint32_t value)
+{
+    for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+    {
+        if(mask & (1u << gpio))
+        {
+            gpio_put(gpio, value & (1u << gpio));
+        }
+    }
+}
+
+
+void gpio_put_all(uint32_t value)
+{
+    gpio_put_masked((1u << NUM_BANK0_GPIOS) - 1, value);
+}
+
+
+bool gpio_get(uint gpio)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    return level(gpio);
+}
+
+
+uint32_t gpio_get_all(void)
+{
+    std::lock_guard<std::mutex> guard(bank().lock);
+    uint32_t all = 0;
+    for(uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++)
+    {
+        all |= static_cast<uint32_t>(level(gpio)) << gpio;
+    }
+    return all;
+}
+
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> guard(bank().lock);
+        if(enabled)
+        {
+            bank().pins[gpio].irqEvents |= events;
+            bank().pins[gpio].lastLevel = level(gpio);
+        }
+        else
+        {
+            bank().pins[gpio].irqEvents &= ~events;
+        }
+    }
+
+    if(enabled)
+    {
+        std::call_once(pollerStarted, []() { std::thread(pollIrqs).detach(); });
+    }
+}
+
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback)
+{
+    gpio_set_irq_enabled(gpio, events, enabled);
+    irqCallback = callback;
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
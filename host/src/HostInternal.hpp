@@ -0,0 +1,48 @@
+#ifndef __HOST_INTERNAL_HPP
+#define __HOST_INTERNAL_HPP
+
+#include <mutex>
+#include "pico.h"
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+/// @brief Lock standing in for "interrupts disabled", held while a simulated IRQ handler runs
+std::recursive_mutex &irqLock();
+
+/// @brief True if the pin is configured as output and its latch is low
+bool gpioDrivenLow(uint gpio);
+
+/// @brief Chip select edge, forwarded to the SPI devices attached to the pin
+void spiChipSelect(uint gpio, bool level);
+
+/// @brief DMA read of the UART data register, false if the RX FIFO is empty
+bool uartDmaRead(uint index, uint8_t &byte);
+
+/// @brief DMA write of the UART data register, the byte goes out at once
+void uartDmaWrite(uint index, uint8_t byte);
+
+/// @brief Peripheral has data for its DREQ, paced channels waiting on it move their bytes
+void dmaRequest(uint dreq);
+
+
+// power on state of the individual peripherals, see Sim::reset()
+void resetTime();
+void resetGpio();
+void resetAdc();
+void resetSpi();
+void resetI2c();
+void resetFlash();
+void resetClocks();
+void resetDma();
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+#endif // !__HOST_INTERNAL_HPP
@@ -0,0 +1,113 @@
+#include "hardware/i2c.h"
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+
+#include <map>
+#include <utility>
+
+
+i2c_inst_t host_i2c_inst[2] = {{0}, {1}};
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+struct Bus
+{
+    std::mutex lock;
+    std::map<std::pair<uint, uint8_t>, I2cDevice *> devices;
+};
+
+
+Bus &bus()
+{
+    static Bus instance;
+    return instance;
+}
+
+
+/// @brief device acking the address, nullptr if none
+I2cDevice *addressed(const i2c_inst_t *i2c, uint8_t address)
+{
+    std::lock_guard<std::mutex> guard(bus().lock);
+    auto it = bus().devices.find({i2c->index, address});
+    return it == bus().devices.end() ? nullptr : it->second;
+}
+
+} // namespace
+
+
+void attachI2cDevice(i2c_inst_t *i2c, uint8_t address, I2cDevice *device)
+{
+    std::lock_guard<std::mutex> guard(bus().lock);
+    if(device)
+    {
+        bus().devices[{i2c->index, address}] = device;
+    }
+    else
+    {
+        bus().devices.erase({i2c->index, address});
+    }
+}
+
+
+void resetI2c()
+{
+    std::lock_guard<std::mutex> guard(bus().lock);
+    bus().devices.clear();
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    (void)i2c;
+    return baudrate;
+}
+
+
+void i2c_deinit(i2c_inst_t *i2c)
+{
+    (void)i2c;
+}
+
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate)
+{
+    (void)i2c;
+    return baudrate;
+}
+
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    I2cDevice *device = addressed(i2c, addr);
+    if(!device)
+    {
+        return PICO_ERROR_GENERIC;
+    }
+    return device->write(src, len, nostop);
+}
+
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    I2cDevice *device = addressed(i2c, addr);
+    if(!device)
+    {
+        return PICO_ERROR_GENERIC;
+    }
+    return device->read(dst, len, nostop);
+}
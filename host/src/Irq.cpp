@@ -0,0 +1,137 @@
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "HostInternal.hpp"
+
+#include <atomic>
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+std::recursive_mutex &irqLock()
+{
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+namespace
+{
+
+std::atomic<irq_handler_t> handlers[IRQ_COUNT] {};
+std::atomic<irq_handler_t> sharedHandlers[IRQ_COUNT][PICO_MAX_SHARED_IRQ_HANDLERS] {};
+std::atomic<bool> enabled[IRQ_COUNT] {};
+
+} // namespace
+
+
+uint32_t save_and_disable_interrupts(void)
+{
+    Xerxes::Sim::irqLock().lock();
+    return 0;
+}
+
+
+void restore_interrupts(uint32_t status)
+{
+    (void)status;
+    Xerxes::Sim::irqLock().unlock();
+}
+
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler)
+{
+    handlers[num] = handler;
+}
+
+
+irq_handler_t irq_get_exclusive_handler(uint num)
+{
+    return handlers[num];
+}
+
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority)
+{
+    // order priority is not simulated
+    (void)order_priority;
+    for(auto &shared : sharedHandlers[num])
+    {
+        irq_handler_t expected = nullptr;
+        if(shared.compare_exchange_strong(expected, handler))
+        {
+            return;
+        }
+    }
+    assert(false && "too many shared handlers");
+}
+
+
+void irq_remove_handler(uint num, irq_handler_t handler)
+{
+    irq_handler_t expected = handler;
+    handlers[num].compare_exchange_strong(expected, nullptr);
+    for(auto &shared : sharedHandlers[num])
+    {
+        expected = handler;
+        shared.compare_exchange_strong(expected, nullptr);
+    }
+}
+
+
+void irq_set_enabled(uint num, bool enable)
+{
+    enabled[num] = enable;
+}
+
+
+bool irq_is_enabled(uint num)
+{
+    return enabled[num];
+}
+
+
+void irq_set_priority(uint num, uint8_t hardware_priority)
+{
+    // handlers are not preempted on host, priorities have no effect
+    (void)num;
+    (void)hardware_priority;
+}
+
+
+void irq_clear(uint num)
+{
+    (void)num;
+}
+
+
+void irq_set_pending(uint num)
+{
+    if(!enabled[num])
+    {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> guard(Xerxes::Sim::irqLock());
+    irq_handler_t handler = handlers[num];
+    if(handler)
+    {
+        handler();
+        return;
+    }
+    for(auto &shared : sharedHandlers[num])
+    {
+        handler = shared;
+        if(handler)
+        {
+            handler();
+        }
+    }
+}
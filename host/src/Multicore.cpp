@@ -0,0 +1,57 @@
+#include "pico/multicore.h"
+
+#include <thread>
+
+
+namespace
+{
+
+thread_local uint coreNum = 0;
+
+} // namespace
+
+
+void multicore_launch_core1(void (*entry)(void))
+{
+    std::thread core1([entry]()
+    {
+        coreNum = 1;
+        entry();
+    });
+    core1.detach();
+}
+
+
+void multicore_lockout_victim_init(void)
+{
+}
+
+
+bool multicore_lockout_start_timeout_us(uint64_t timeout_us)
+{
+    (void)timeout_us;
+    return true;
+}
+
+
+bool multicore_lockout_end_timeout_us(uint64_t timeout_us)
+{
+    (void)timeout_us;
+    return true;
+}
+
+
+void multicore_lockout_start_blocking(void)
+{
+}
+
+
+void multicore_lockout_end_blocking(void)
+{
+}
+
+
+uint get_core_num(void)
+{
+    return coreNum;
+}
@@ -0,0 +1,132 @@
+#include "pico/util/queue.h"
+
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+
+void queue_init(queue_t *q, uint element_size, uint element_count)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    delete[] q->data;
+
+    // one slot is always kept free to tell full from empty, same as pico-sdk
+    q->data = new uint8_t[element_size * (element_count + 1)];
+    q->element_count = static_cast<uint16_t>(element_count);
+    q->element_size = static_cast<uint16_t>(element_size);
+    q->wptr = 0;
+    q->rptr = 0;
+}
+
+
+void queue_free(queue_t *q)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    delete[] q->data;
+    q->data = nullptr;
+}
+
+
+uint queue_get_level_unsafe(queue_t *q)
+{
+    int32_t rc = static_cast<int32_t>(q->wptr) - static_cast<int32_t>(q->rptr);
+    if(rc < 0)
+    {
+        rc += q->element_count + 1;
+    }
+    return static_cast<uint>(rc);
+}
+
+
+uint queue_get_level(queue_t *q)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    return queue_get_level_unsafe(q);
+}
+
+
+static inline uint16_t inc_index(queue_t *q, uint16_t index)
+{
+    if(++index > q->element_count)
+    {
+        index = 0;
+    }
+    return index;
+}
+
+
+static bool queue_add_internal(queue_t *q, const void *data)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    if(queue_get_level_unsafe(q) == q->element_count)
+    {
+        return false;
+    }
+    std::memcpy(q->data + q->wptr * q->element_size, data, q->element_size);
+    q->wptr = inc_index(q, q->wptr);
+    return true;
+}
+
+
+static bool queue_remove_internal(queue_t *q, void *data, bool remove)
+{
+    std::lock_guard<std::mutex> guard(q->lock);
+    if(queue_get_level_unsafe(q) == 0)
+    {
+        return false;
+    }
+    if(data)
+    {
+        std::memcpy(data, q->data + q->rptr * q->element_size, q->element_size);
+    }
+    if(remove)
+    {
+        q->rptr = inc_index(q, q->rptr);
+    }
+    return true;
+}
+
+
+bool queue_try_add(queue_t *q, const void *data)
+{
+    return queue_add_internal(q, data);
+}
+
+
+bool queue_try_remove(queue_t *q, void *data)
+{
+    return queue_remove_internal(q, data, true);
+}
+
+
+bool queue_try_peek(queue_t *q, void *data)
+{
+    return queue_remove_internal(q, data, false);
+}
+
+
+void queue_add_blocking(queue_t *q, const void *data)
+{
+    while(!queue_add_internal(q, data))
+    {
+        std::this_thread::yield();
+    }
+}
+
+
+void queue_remove_blocking(queue_t *q, void *data)
+{
+    while(!queue_remove_internal(q, data, true))
+    {
+        std::this_thread::yield();
+    }
+}
+
+
+void queue_peek_blocking(queue_t *q, void *data)
+{
+    while(!queue_remove_internal(q, data, false))
+    {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file Shield.cpp
+ * @brief Simulated shield of the host firmware build, selected by __SHIELD_<X>
+ *
+ * Attaches device models and signal generators to the simulated HAL before
+ * main() runs so the firmware finds the same hardware as on the real board.
+ */
+#include "HostHal.hpp"
+#include "Devices/Scl3x00Model.hpp"
+#include "Devices/AbpModel.hpp"
+#include "Devices/Ads1115Model.hpp"
+#include "Devices/Hx711Model.hpp"
+#include "Hardware/Board/xerxes_rp2040.h"
+
+#if defined(__SHIELD_4DI4DO) || defined(__SHIELD_ENCODER) || defined(__SHIELD_CUTTER)
+#include "Sensors/Generic/DIO/4DI4DO.hpp"
+#endif
+
+
+namespace
+{
+
+using namespace Xerxes;
+using namespace Xerxes::Sim;
+
+
+void wireShield()
+{
+#if defined(__SHIELD_SCL3300) || defined(__SHIELD_SCL3400)
+#if defined(__SHIELD_SCL3300)
+    static Scl3x00Model inclinometer = Scl3x00Model::scl3300();
+#else
+    static Scl3x00Model inclinometer = Scl3x00Model::scl3400();
+#endif
+    // slow swing around X, steady Y, both with sensor noise
+    inclinometer.setAngle(0, sine(0.5, 0.1, 10) + noise(0.01, 0, 1));
+    inclinometer.setAngle(1, constant(5) + noise(0.01, 0, 2));
+    inclinometer.setAngle(2, constant(80));
+    inclinometer.setTemperature(constant(25) + noise(0.1, 0, 3));
+    attachSpiDevice(spi0, SPI0_CSN_PIN, &inclinometer);
+
+#elif defined(__SHIELD_ABP)
+    static AbpModel pressureSensor(0, 6000);
+    pressureSensor.setPressure(sine(50, 0.2, 1000) + noise(2));
+    pressureSensor.setTemperature(constant(25));
+    attachSpiDevice(spi0, SPI0_CSN_PIN, &pressureSensor);
+
+#elif defined(__SHIELD_AI) || defined(__SHIELD_ENVIROLS)
+    setAdcSignal(0, sine(1, 1, 1.5) + noise(0.005, 0, 1));
+    setAdcSignal(1, sine(0.2, 50, 1.5) + noise(0.005, 0, 2));
+    setAdcSignal(2, constant(1.0) + noise(0.005, 0, 3));
+    setAdcSignal(3, ramp(0.01, 0.5));
+
+#elif defined(__SHIELD_DISCRETE_AI)
+    static Ads1115Model adc;
+    adc.setInput(0, sine(0.5, 0.5, 1.25) + noise(0.001, 0, 1));
+    adc.setInput(1, constant(1.0) + noise(0.001, 0, 2));
+    adc.setInput(2, ramp(0.001, 0.1));
+    adc.setInput(3, constant(2.5));  // reference voltage
+    attachI2cDevice(i2c0, 0x48, &adc);
+
+#elif defined(__SHIELD_HX711)
+    static Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(sine(20000, 0.2, 100000) + noise(50));
+    attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+#elif defined(__SHIELD_ENCODER) || defined(__SHIELD_CUTTER)
+    // shaft turning at 200 counts per second
+    Signal position = ramp(200);
+    setGpioSignal(DI0_PIN, quadrature(position, 0));
+    setGpioSignal(DI1_PIN, quadrature(position, 1));
+    setGpioSignal(DI2_PIN, constant(0));
+
+#elif defined(__SHIELD_4DI4DO)
+    setGpioSignal(DI0_PIN, square(0, 1, 1));
+    setGpioSignal(DI1_PIN, square(0, 1, 2));
+    setGpioSignal(DI2_PIN, constant(1));
+    setGpioSignal(DI3_PIN, constant(0));
+
+#elif defined(__SHIELD_TEMP)
+    // 1-Wire is not modelled, DS18B20 reads the bus pull-up as disconnected sensor
+#endif
+}
+
+
+struct Wiring
+{
+    Wiring() { wireShield(); }
+} wiring;
+
+} // namespace
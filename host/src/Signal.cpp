@@ -0,0 +1,106 @@
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+Signal constant(double value)
+{
+    return [value](uint64_t) { return value; };
+}
+
+
+Signal sine(double amplitude, double frequencyHz, double offset, double phaseRad)
+{
+    return [=](uint64_t timeUs)
+    {
+        return offset + amplitude * std::sin(2 * M_PI * frequencyHz * (timeUs * 1e-6) + phaseRad);
+    };
+}
+
+
+Signal noise(double stdDev, double mean, uint32_t seed)
+{
+    // generator is shared by copies of the signal so the sequence does not repeat
+    struct State
+    {
+        std::mutex lock;
+        std::mt19937 engine;
+        std::normal_distribution<double> dist;
+    };
+    auto state = std::make_shared<State>();
+    state->engine.seed(seed);
+    state->dist = std::normal_distribution<double>(mean, stdDev);
+
+    return [state](uint64_t)
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        return state->dist(state->engine);
+    };
+}
+
+
+Signal ramp(double slopePerSecond, double offset)
+{
+    return [=](uint64_t timeUs) { return offset + slopePerSecond * (timeUs * 1e-6); };
+}
+
+
+Signal square(double low, double high, double frequencyHz)
+{
+    return [=](uint64_t timeUs)
+    {
+        double phase = std::fmod(timeUs * 1e-6 * frequencyHz, 1.0);
+        return phase < 0.5 ? low : high;
+    };
+}
+
+
+Signal quadrature(Signal positionCounts, uint channel)
+{
+    return [positionCounts, channel](uint64_t timeUs)
+    {
+        // one period of A and B spans 4 counts, B leads A by one count when turning forward
+        int64_t pos = static_cast<int64_t>(std::floor(positionCounts(timeUs))) + channel;
+        int64_t phase = ((pos % 4) + 4) % 4;
+        return phase < 2 ? 1.0 : 0.0;
+    };
+}
+
+
+Signal operator+(Signal a, Signal b)
+{
+    return [a, b](uint64_t timeUs) { return a(timeUs) + b(timeUs); };
+}
+
+
+Signal operator*(Signal a, Signal b)
+{
+    return [a, b](uint64_t timeUs) { return a(timeUs) * b(timeUs); };
+}
+
+
+void reset()
+{
+    resetTime();
+    resetGpio();
+    resetAdc();
+    resetSpi();
+    resetI2c();
+    resetFlash();
+    resetClocks();
+    resetDma();
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
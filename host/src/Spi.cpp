@@ -0,0 +1,168 @@
+#include "hardware/spi.h"
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+
+#include <cstring>
+#include <vector>
+
+
+spi_inst_t host_spi_inst[2] = {{0}, {1}};
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+struct Attachment
+{
+    uint bus;
+    uint csPin;
+    SpiDevice *device;
+};
+
+struct Bus
+{
+    std::mutex lock;
+    std::vector<Attachment> devices;
+};
+
+
+Bus &bus()
+{
+    static Bus instance;
+    return instance;
+}
+
+
+/// @brief device currently selected on the bus, nullptr if none
+SpiDevice *selected(const spi_inst_t *spi)
+{
+    std::lock_guard<std::mutex> guard(bus().lock);
+    for(const auto &el : bus().devices)
+    {
+        if(el.bus == spi->index && gpioDrivenLow(el.csPin))
+        {
+            return el.device;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+
+void attachSpiDevice(spi_inst_t *spi, uint csPin, SpiDevice *device)
+{
+    std::lock_guard<std::mutex> guard(bus().lock);
+    auto &devices = bus().devices;
+    for(auto it = devices.begin(); it != devices.end(); ++it)
+    {
+        if(it->bus == spi->index && it->csPin == csPin)
+        {
+            devices.erase(it);
+            break;
+        }
+    }
+
+    if(device)
+    {
+        devices.push_back({spi->index, csPin, device});
+    }
+}
+
+
+void spiChipSelect(uint gpio, bool level)
+{
+    std::vector<SpiDevice *> toNotify;
+    {
+        std::lock_guard<std::mutex> guard(bus().lock);
+        for(const auto &el : bus().devices)
+        {
+            if(el.csPin == gpio) toNotify.push_back(el.device);
+        }
+    }
+
+    for(auto device : toNotify)
+    {
+        device->select(!level);
+    }
+}
+
+
+void resetSpi()
+{
+    std::lock_guard<std::mutex> guard(bus().lock);
+    bus().devices.clear();
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+uint spi_init(spi_inst_t *spi, uint baudrate)
+{
+    (void)spi;
+    return baudrate;
+}
+
+
+void spi_deinit(spi_inst_t *spi)
+{
+    (void)spi;
+}
+
+
+uint spi_set_baudrate(spi_inst_t *spi, uint baudrate)
+{
+    (void)spi;
+    return baudrate;
+}
+
+
+void spi_set_format(spi_inst_t *spi, uint data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order)
+{
+    (void)spi;
+    (void)data_bits;
+    (void)cpol;
+    (void)cpha;
+    (void)order;
+}
+
+
+int spi_write_read_blocking(spi_inst_t *spi, const uint8_t *src, uint8_t *dst, size_t len)
+{
+    SpiDevice *device = selected(spi);
+    if(device)
+    {
+        device->transfer(src, dst, len);
+    }
+    else
+    {
+        // MISO is pulled up when nobody drives it
+        std::memset(dst, 0xFF, len);
+    }
+    return static_cast<int>(len);
+}
+
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len)
+{
+    std::vector<uint8_t> discard(len);
+    return spi_write_read_blocking(spi, src, discard.data(), len);
+}
+
+
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len)
+{
+    std::vector<uint8_t> tx(len, repeated_tx_data);
+    return spi_write_read_blocking(spi, tx.data(), dst, len);
+}
@@ -0,0 +1,110 @@
+#include "pico/time.h"
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<TimeMode> mode {TimeMode::REAL};
+std::atomic<uint64_t> virtualUs {0};
+std::atomic<Clock::rep> epoch {Clock::now().time_since_epoch().count()};
+
+} // namespace
+
+
+void setTimeMode(TimeMode newMode)
+{
+    mode = newMode;
+    resetTime();
+}
+
+
+TimeMode getTimeMode()
+{
+    return mode;
+}
+
+
+void advanceTime(uint64_t us)
+{
+    if(mode == TimeMode::VIRTUAL)
+    {
+        virtualUs += us;
+    }
+}
+
+
+void resetTime()
+{
+    virtualUs = 0;
+    epoch = Clock::now().time_since_epoch().count();
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+uint64_t time_us_64(void)
+{
+    if(mode == TimeMode::VIRTUAL)
+    {
+        return virtualUs;
+    }
+
+    auto elapsed = Clock::now().time_since_epoch() - Clock::duration(epoch.load());
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+
+uint32_t time_us_32(void)
+{
+    return static_cast<uint32_t>(time_us_64());
+}
+
+
+void sleep_us(uint64_t us)
+{
+    if(mode == TimeMode::VIRTUAL)
+    {
+        virtualUs += us;
+    }
+    else if(us)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us(ms * 1000ull);
+}
+
+
+void busy_wait_us(uint64_t us)
+{
+    sleep_us(us);
+}
+
+
+void busy_wait_us_32(uint32_t us)
+{
+    sleep_us(us);
+}
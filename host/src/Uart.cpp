@@ -0,0 +1,374 @@
+#include "hardware/uart.h"
+#include "hardware/irq.h"
+#include "HostHal.hpp"
+#include "HostInternal.hpp"
+#include "pico/time.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+
+uart_inst_t host_uart_inst[2] = {{0}, {1}};
+uart_hw_t host_uart_hw[2] {};
+
+
+namespace Xerxes
+{
+namespace Sim
+{
+
+
+namespace
+{
+
+constexpr size_t fifoDepth = 32;
+constexpr uint bitsPerFrame = 10;  // start + 8 data + stop
+
+struct Port
+{
+    std::mutex lock;
+    int master = -1;
+    int slave = -1;
+    uint baudrate = 0;
+    bool fifoEnabled = false;
+    bool rxIrq = false;
+    std::deque<uint8_t> rx;
+    UartListener listener;
+};
+
+std::atomic<bool> wireTiming {true};
+
+
+Port &port(uint index)
+{
+    static Port ports[2];
+    return ports[index];
+}
+
+
+uint64_t frameTimeUs(uint baudrate, size_t len)
+{
+    return baudrate ? len * bitsPerFrame * 1'000'000ull / baudrate : 0;
+}
+
+
+/// @brief bytes go out on the line: to the pty and the listener
+void transmit(uint index, const uint8_t *src, size_t len)
+{
+    Port &p = port(index);
+    size_t written = 0;
+    while(p.master >= 0 && written < len)
+    {
+        ssize_t rc = write(p.master, src + written, len - written);
+        if(rc <= 0) break;
+        written += rc;
+    }
+
+    UartListener listener;
+    {
+        std::lock_guard<std::mutex> guard(p.lock);
+        listener = p.listener;
+    }
+    if(listener)
+    {
+        for(size_t i = 0; i < len; i++)
+        {
+            listener(src[i]);
+        }
+    }
+}
+
+
+/// @brief byte arrived on the line: RX FIFO, then DMA if a channel waits for it, then the IRQ
+void deliver(uint index, uint8_t byte)
+{
+    Port &p = port(index);
+    {
+        std::lock_guard<std::mutex> guard(p.lock);
+        size_t depth = p.fifoEnabled ? fifoDepth : 1;
+        if(p.rx.size() < depth)
+        {
+            p.rx.push_back(byte);
+        }
+        // else: overrun, the byte is lost as on the chip
+    }
+
+    dmaRequest(DREQ_UART0_RX + 2 * index);
+
+    bool irq;
+    {
+        std::lock_guard<std::mutex> guard(p.lock);
+        irq = p.rxIrq && !p.rx.empty();
+    }
+    if(irq)
+    {
+        irq_set_pending(UART0_IRQ + index);
+    }
+}
+
+
+/// @brief move bytes from the pty to the RX FIFO at the line rate
+void receive(uint index)
+{
+    using Clock = std::chrono::steady_clock;
+    Port &p = port(index);
+    auto slot = Clock::now();
+    uint8_t chunk[64];
+
+    while(true)
+    {
+        pollfd pfd {p.master, POLLIN, 0};
+        if(poll(&pfd, 1, 100) <= 0)
+        {
+            continue;
+        }
+
+        ssize_t len = read(p.master, chunk, sizeof(chunk));
+        if(len <= 0)
+        {
+            // no client connected to the slave side yet
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        slot = std::max(slot, Clock::now());
+        for(ssize_t i = 0; i < len; i++)
+        {
+            {
+                std::lock_guard<std::mutex> guard(p.lock);
+                if(wireTiming)
+                {
+                    slot += std::chrono::microseconds(frameTimeUs(p.baudrate, 1));
+                }
+            }
+
+            std::this_thread::sleep_until(slot);
+            deliver(index, chunk[i]);
+        }
+    }
+}
+
+
+/// @brief open pty for the port, print and link the slave name
+void openPty(uint index)
+{
+    Port &p = port(index);
+    if(p.master >= 0)
+    {
+        return;
+    }
+
+    p.master = posix_openpt(O_RDWR | O_NOCTTY);
+    if(p.master < 0 || grantpt(p.master) || unlockpt(p.master))
+    {
+        std::perror("uart: cannot create pty");
+        std::exit(EXIT_FAILURE);
+    }
+
+    // writes are dropped if nobody reads the other side, as on an idle bus
+    fcntl(p.master, F_SETFL, fcntl(p.master, F_GETFL) | O_NONBLOCK);
+
+    std::string name = ptsname(p.master);
+
+    // keep the slave open so the master does not hang up between clients
+    p.slave = ::open(name.c_str(), O_RDWR | O_NOCTTY);
+    termios tio;
+    tcgetattr(p.slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(p.slave, TCSANOW, &tio);
+
+    std::fprintf(stderr, "uart%u: %s\n", index, name.c_str());
+
+    const char *link = std::getenv("XERXES_HOST_PTY_LINK");
+    if(link)
+    {
+        std::string linkName = std::string(link) + (index ? std::to_string(index) : "");
+        unlink(linkName.c_str());
+        if(symlink(name.c_str(), linkName.c_str()))
+        {
+            std::perror("uart: cannot link pty");
+        }
+        else
+        {
+            std::fprintf(stderr, "uart%u: %s -> %s\n", index, linkName.c_str(), name.c_str());
+        }
+    }
+
+    std::thread(receive, index).detach();
+}
+
+} // namespace
+
+
+void setUartWireTiming(bool enabled)
+{
+    wireTiming = enabled;
+}
+
+
+void receiveUart(uint index, const uint8_t *src, size_t len)
+{
+    for(size_t i = 0; i < len; i++)
+    {
+        deliver(index, src[i]);
+    }
+}
+
+
+void setUartListener(uint index, UartListener listener)
+{
+    std::lock_guard<std::mutex> guard(port(index).lock);
+    port(index).listener = listener;
+}
+
+
+void uartDmaWrite(uint index, uint8_t byte)
+{
+    transmit(index, &byte, 1);
+}
+
+
+bool uartDmaRead(uint index, uint8_t &byte)
+{
+    Port &p = port(index);
+    std::lock_guard<std::mutex> guard(p.lock);
+    if(p.rx.empty())
+    {
+        return false;
+    }
+    byte = p.rx.front();
+    p.rx.pop_front();
+    return true;
+}
+
+
+} // namespace Sim
+} // namespace Xerxes
+
+
+using namespace Xerxes::Sim;
+
+
+uint uart_init(uart_inst_t *uart, uint baudrate)
+{
+    {
+        std::lock_guard<std::mutex> guard(port(uart->index).lock);
+        port(uart->index).baudrate = baudrate;
+        port(uart->index).rx.clear();
+    }
+    openPty(uart->index);
+    return baudrate;
+}
+
+
+void uart_deinit(uart_inst_t *uart)
+{
+    std::lock_guard<std::mutex> guard(port(uart->index).lock);
+    port(uart->index).rxIrq = false;
+}
+
+
+uint uart_set_baudrate(uart_inst_t *uart, uint baudrate)
+{
+    std::lock_guard<std::mutex> guard(port(uart->index).lock);
+    port(uart->index).baudrate = baudrate;
+    return baudrate;
+}
+
+
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled)
+{
+    std::lock_guard<std::mutex> guard(port(uart->index).lock);
+    port(uart->index).fifoEnabled = enabled;
+}
+
+
+void uart_set_irq_enables(uart_inst_t *uart, bool rx_has_data, bool tx_needs_data)
+{
+    (void)tx_needs_data;
+    std::lock_guard<std::mutex> guard(port(uart->index).lock);
+    port(uart->index).rxIrq = rx_has_data;
+}
+
+
+uint uart_get_index(uart_inst_t *uart)
+{
+    return uart->index;
+}
+
+
+uart_hw_t *uart_get_hw(uart_inst_t *uart)
+{
+    return &host_uart_hw[uart->index];
+}
+
+
+bool uart_is_readable(uart_inst_t *uart)
+{
+    std::lock_guard<std::mutex> guard(port(uart->index).lock);
+    return !port(uart->index).rx.empty();
+}
+
+
+bool uart_is_writable(uart_inst_t *uart)
+{
+    (void)uart;
+    return true;
+}
+
+
+char uart_getc(uart_inst_t *uart)
+{
+    while(!uart_is_readable(uart))
+    {
+        std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> guard(port(uart->index).lock);
+    char c = static_cast<char>(port(uart->index).rx.front());
+    port(uart->index).rx.pop_front();
+    return c;
+}
+
+
+void uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len)
+{
+    for(size_t i = 0; i < len; i++)
+    {
+        dst[i] = static_cast<uint8_t>(uart_getc(uart));
+    }
+}
+
+
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len)
+{
+    Port &p = port(uart->index);
+    transmit(uart->index, src, len);
+
+    if(wireTiming)
+    {
+        sleep_us(frameTimeUs(p.baudrate, len));
+    }
+}
+
+
+void uart_putc_raw(uart_inst_t *uart, char c)
+{
+    uart_write_blocking(uart, reinterpret_cast<const uint8_t *>(&c), 1);
+}
+
+
+void uart_tx_wait_blocking(uart_inst_t *uart)
+{
+    (void)uart;
+}
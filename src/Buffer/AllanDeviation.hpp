@@ -0,0 +1,196 @@
+#ifndef ALLAN_DEVIATION_HPP
+#define ALLAN_DEVIATION_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Allan deviation for octave spaced tau = 1 s, 2 s, 4 s ... 2^(NTaus - 1) s
+ *
+ * Samples are averaged into half second blocks. Every level of the cascade
+ * averages pairs of completed blocks of the level below, so level j holds
+ * blocks of 2^j / 2 s. Two adjacent tau-averages are made of the last four
+ * half-tau blocks of a level, their difference is taken every time a block
+ * completes - every tau / 2, so consecutive differences overlap by half.
+ * Fully overlapping differences (stride of one sample) would need the whole
+ * last 2 * tau of samples, the cascade keeps 4 blocks per level and memory is
+ * O(log tau_max).
+ *
+ * Sum of squared differences keeps growing from the first sample until
+ * clear(), the estimate gets better with time as on the host. A block without
+ * samples (gap) restarts the blocks but keeps the sums.
+ *
+ * @tparam NTaus - number of octaves, tau_max = 2^(NTaus - 1) s
+ */
+template <uint32_t NTaus>
+class AllanDeviation
+{
+public:
+    constexpr static uint64_t BLOCK_US = 500'000;   ///< length of the base block, half of the shortest tau
+
+protected:
+    struct Level
+    {
+        std::array<double, 4> blocks {};    ///< last completed block averages, oldest first
+        uint32_t filled {0};                ///< valid blocks, up to 4
+        double pending {0};                 ///< completed block waiting for its pair
+        bool hasPending {false};
+        double sumSq {0};                   ///< sum of squared differences of adjacent tau-averages
+        uint32_t differences {0};           ///< number of summed differences
+    };
+
+    std::array<Level, NTaus> levels;
+
+    bool started {false};
+    uint64_t block {0};     ///< index of the running base block since boot
+    double blockSum {0};    ///< sum of the samples of the running base block
+    uint32_t blockCount {0};
+
+    /// @brief Add completed block average to a level, fold pairs into the level above
+    void push(uint32_t level, double average);
+
+    /// @brief Drop incomplete blocks of all levels after a gap
+    void restart();
+
+public:
+    AllanDeviation() = default;
+
+    /**
+     * @brief Add sample taken at given time
+     *
+     * @param el - sample, NaN is skipped
+     * @param timeUs - time since boot in microseconds, must not decrease
+     * @return true if a block was completed and the deviation may have changed
+     */
+    bool insert(const float &el, const uint64_t &timeUs);
+
+    /// @brief Drop all blocks and sums
+    void clear();
+
+    /// @brief Number of differences behind the deviation of tau = 2^level s
+    const uint32_t & getDifferences(const uint32_t &level) const { return levels[level].differences; }
+
+    /**
+     * @brief Copy Allan deviation of tau = 1 s, 2 s ... to an array of NTaus floats
+     *
+     * NaN for tau without a difference yet.
+     */
+    void getDeviation(float* deviation) const;
+};
+
+
+template <uint32_t NTaus>
+void AllanDeviation<NTaus>::clear()
+{
+    levels.fill({});
+    started = false;
+    blockSum = 0;
+    blockCount = 0;
+}
+
+
+template <uint32_t NTaus>
+void AllanDeviation<NTaus>::restart()
+{
+    for(auto &level : levels)
+    {
+        level.filled = 0;
+        level.hasPending = false;
+    }
+}
+
+
+template <uint32_t NTaus>
+void AllanDeviation<NTaus>::push(uint32_t level, double average)
+{
+    // iterative cascade, a completed pair goes one level up
+    while(level < NTaus)
+    {
+        Level &l = levels[level];
+        l.blocks = {l.blocks[1], l.blocks[2], l.blocks[3], average};
+        if(l.filled < 4)
+        {
+            l.filled++;
+        }
+
+        // difference of the two adjacent tau-averages made of the last four half-tau blocks
+        if(l.filled == 4)
+        {
+            const double diff = ((l.blocks[2] + l.blocks[3]) - (l.blocks[0] + l.blocks[1])) / 2;
+            l.sumSq += diff * diff;
+            l.differences++;
+        }
+
+        if(!l.hasPending)
+        {
+            l.pending = average;
+            l.hasPending = true;
+            return;
+        }
+        l.hasPending = false;
+        average = (l.pending + average) / 2;
+        level++;
+    }
+}
+
+
+template <uint32_t NTaus>
+bool AllanDeviation<NTaus>::insert(const float &el, const uint64_t &timeUs)
+{
+    if(el != el)
+    {
+        return false;
+    }
+
+    const uint64_t now = timeUs / BLOCK_US;
+    bool changed = false;
+
+    if(!started)
+    {
+        started = true;
+        block = now;
+    }
+
+    if(now != block)
+    {
+        if(blockCount > 0)
+        {
+            push(0, blockSum / blockCount);
+            changed = true;
+        }
+
+        // blocks without samples break the averages
+        if(now > block + 1)
+        {
+            restart();
+        }
+        block = now;
+        blockSum = 0;
+        blockCount = 0;
+    }
+
+    blockSum += el;
+    blockCount++;
+    return changed;
+}
+
+
+template <uint32_t NTaus>
+void AllanDeviation<NTaus>::getDeviation(float* deviation) const
+{
+    for(uint32_t i = 0; i < NTaus; i++)
+    {
+        const Level &l = levels[i];
+        deviation[i] = l.differences > 0 ? sqrt(l.sumSq / (2.0 * l.differences)) : NAN;
+    }
+}
+
+
+} // namespace Xerxes
+
+#endif // !ALLAN_DEVIATION_HPP
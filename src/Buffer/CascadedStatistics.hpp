@@ -0,0 +1,249 @@
+#ifndef CASCADED_STATISTICS_HPP
+#define CASCADED_STATISTICS_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Summary of a block of samples - count, sum, sum of squares, min and max
+ *
+ * Sums are kept relative to a reference value given by the owner, so summaries
+ * of the same owner can be merged by adding them up.
+ *
+ * @tparam T - type of the samples
+ * @tparam Sum - type of the sums
+ */
+template <class T, class Sum = double>
+struct Summary
+{
+    uint32_t count {0};
+    Sum sum {0};    ///< sum of (el - shift)
+    Sum sumSq {0};  ///< sum of (el - shift)^2
+    T min {0};
+    T max {0};
+
+    void add(const T &el, const Sum &dev)
+    {
+        if(count == 0 || el < min) min = el;
+        if(count == 0 || el > max) max = el;
+        count++;
+        sum += dev;
+        sumSq += dev * dev;
+    }
+
+    void merge(const Summary &other)
+    {
+        if(other.count == 0) return;
+        if(count == 0 || other.min < min) min = other.min;
+        if(count == 0 || other.max > max) max = other.max;
+        count += other.count;
+        sum += other.sum;
+        sumSq += other.sumSq;
+    }
+};
+
+
+/**
+ * @brief Statistics of the last 1 s, 10 s and 60 s from summaries instead of samples
+ *
+ * Samples are folded into a summary of the running second. Every completed
+ * second is kept in a ring of 10 seconds, every completed 10 seconds (aligned
+ * to multiples of 10 s) is merged into a ring of 6 ten-second summaries. The
+ * windows are merged from the rings on request:
+ *  - 1 s: last completed second
+ *  - 10 s: last 10 completed seconds, moves every second
+ *  - 60 s: last 6 completed ten-second blocks, moves every 10 s
+ *
+ * Memory is 17 summaries regardless of the sample rate, a 60 s window at 1 kHz
+ * takes a few hundred bytes instead of 60000 samples. Sums are relative to the
+ * first sample to avoid cancellation in the standard deviation.
+ *
+ * @tparam T - type of the samples
+ * @tparam Sum - type of the sums
+ */
+template <class T, class Sum = double>
+class CascadedStatistics
+{
+public:
+    /// @brief window lengths, index of getStatistics()
+    enum Resolution : uint8_t
+    {
+        SECOND = 0,
+        TEN_SECONDS = 1,
+        MINUTE = 2
+    };
+
+protected:
+    constexpr static uint64_t US_IN_SECOND = 1'000'000;
+    constexpr static uint32_t SECONDS = 10;     ///< seconds in the ten-second block
+    constexpr static uint32_t TENS = 6;         ///< ten-second blocks in the minute
+
+    bool started {false};
+    uint64_t second {0};    ///< index of the running second since boot
+    Sum shift {0};          ///< reference value of the sums
+
+    Summary<T, Sum> running;
+    std::array<Summary<T, Sum>, SECONDS> seconds {};
+    std::array<Summary<T, Sum>, TENS> tens {};
+
+    /// @brief Move the running second to the ring, fold completed ten seconds
+    void closeSecond();
+
+public:
+    CascadedStatistics() = default;
+
+    /**
+     * @brief Add sample taken at given time
+     *
+     * @param el - sample
+     * @param timeUs - time since boot in microseconds, must not decrease
+     * @return true if a second was completed and the windows changed
+     */
+    bool insert(const T &el, const uint64_t &timeUs);
+
+    /// @brief Drop all summaries
+    void clear();
+
+    /// @brief Summary of the window, sums relative to getShift()
+    Summary<T, Sum> getSummary(const Resolution &resolution) const;
+
+    /// @brief Reference value the sums of the summaries are relative to
+    const Sum & getShift() const { return shift; }
+
+    /**
+     * @brief Copy statistics of the window to given pointers, NaN for empty window
+     *
+     * @param resolution - window length
+     */
+    void getStatistics(const Resolution &resolution, float* mean, float* stdDev, float* min, float* max) const;
+};
+
+
+template <class T, class Sum>
+void CascadedStatistics<T, Sum>::clear()
+{
+    started = false;
+    running = {};
+    seconds.fill({});
+    tens.fill({});
+}
+
+
+template <class T, class Sum>
+void CascadedStatistics<T, Sum>::closeSecond()
+{
+    seconds[second % SECONDS] = running;
+    running = {};
+
+    // ten seconds are complete, ring holds seconds of this block
+    if(second % SECONDS == SECONDS - 1)
+    {
+        Summary<T, Sum> block;
+        for(const auto &s : seconds)
+        {
+            block.merge(s);
+        }
+        tens[(second / SECONDS) % TENS] = block;
+    }
+    second++;
+}
+
+
+template <class T, class Sum>
+bool CascadedStatistics<T, Sum>::insert(const T &el, const uint64_t &timeUs)
+{
+    const uint64_t now = timeUs / US_IN_SECOND;
+    bool changed = false;
+
+    // longer gap than the longest window, nothing to keep
+    if(started && now > second + SECONDS * TENS + SECONDS)
+    {
+        clear();
+        changed = true;
+    }
+
+    if(!started)
+    {
+        started = true;
+        second = now;
+        shift = el;
+    }
+
+    // close the running second and empty seconds without samples
+    while(second < now)
+    {
+        closeSecond();
+        changed = true;
+    }
+
+    running.add(el, static_cast<Sum>(el) - shift);
+    return changed;
+}
+
+
+template <class T, class Sum>
+Summary<T, Sum> CascadedStatistics<T, Sum>::getSummary(const Resolution &resolution) const
+{
+    Summary<T, Sum> window;
+    if(!started)
+    {
+        return window;
+    }
+
+    switch(resolution)
+    {
+    case SECOND:
+        // second before the running one, might be empty
+        window = seconds[(second + SECONDS - 1) % SECONDS];
+        break;
+    case TEN_SECONDS:
+        for(const auto &s : seconds)
+        {
+            window.merge(s);
+        }
+        break;
+    case MINUTE:
+        for(const auto &t : tens)
+        {
+            window.merge(t);
+        }
+        break;
+    }
+    return window;
+}
+
+
+template <class T, class Sum>
+void CascadedStatistics<T, Sum>::getStatistics(const Resolution &resolution,
+                                               float* mean,
+                                               float* stdDev,
+                                               float* min,
+                                               float* max) const
+{
+    const Summary<T, Sum> window = getSummary(resolution);
+    if(window.count == 0)
+    {
+        *mean = NAN;
+        *stdDev = NAN;
+        *min = NAN;
+        *max = NAN;
+        return;
+    }
+
+    double meanDev = static_cast<double>(window.sum) / window.count;
+    double variance = static_cast<double>(window.sumSq) / window.count - meanDev * meanDev;
+    *mean = shift + meanDev;
+    *stdDev = sqrt(variance > 0 ? variance : 0);
+    *min = window.min;
+    *max = window.max;
+}
+
+
+} // namespace Xerxes
+
+#endif // !CASCADED_STATISTICS_HPP
@@ -0,0 +1,163 @@
+#ifndef EXPONENTIAL_STATISTICS_HPP
+#define EXPONENTIAL_STATISTICS_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Exponentially weighted mean and standard deviation of NCh channels
+ *
+ * Alternative to the sample window of MultiChannelStatistics for long running
+ * drift monitoring: every sample moves the mean by alpha * (el - mean) and the
+ * variance is weighted the same way, so memory is O(1) per channel and there
+ * is no ring at all.
+ *
+ * Alpha is given as a time constant and a sample period, see setTimeConstant(),
+ * so the bandwidth of the filter does not change with the cycle time. The
+ * state is kept in double, with time constants of hours alpha is ~1e-6 and
+ * the updates would be lost in the rounding of a float mean.
+ *
+ * @tparam NCh - number of channels, 1..8
+ */
+template <uint32_t NCh>
+class ExponentialStatistics
+{
+    static_assert(NCh > 0 && NCh <= 8, "channel mask is 8 bits");
+
+protected:
+    uint8_t channelMask {(1u << NCh) - 1};
+    bool started {false};
+
+    double alpha {1};
+    uint64_t timeConstantUs {0};    ///< time constant alpha was computed for
+    uint32_t periodUs {0};          ///< sample period alpha was computed for
+
+    std::array<double, NCh> mean {};
+    std::array<double, NCh> variance {};
+
+public:
+    ExponentialStatistics() = default;
+
+    /**
+     * @brief Alpha of a first order low pass with given time constant, 1 - exp(-period / tau)
+     *
+     * @param timeConstantUs - time constant tau, 0 for no filtering (alpha = 1)
+     * @param periodUs - time between samples
+     */
+    static double alphaFor(const uint64_t &timeConstantUs, const uint32_t &periodUs);
+
+    /**
+     * @brief Set filter bandwidth, alpha is recomputed only when the arguments change
+     *
+     * @param timeConstantUs - time constant tau, 0 for no filtering
+     * @param periodUs - time between samples, e.g. desiredCycleTimeUs
+     */
+    void setTimeConstant(const uint64_t &timeConstantUs, const uint32_t &periodUs);
+
+    const double & getAlpha() const { return alpha; }
+
+    /// @brief Select channels to process, restarts the statistics
+    void setChannelMask(const uint8_t &mask);
+
+    /// @brief Restart from the next sample
+    void clear() { started = false; }
+
+    /**
+     * @brief Weight one sample of all channels into the statistics, first sample sets the mean
+     *
+     * @param el - NCh consecutive samples, el[i] belongs to channel i
+     */
+    void insert(const float* el);
+
+    /**
+     * @brief Copy mean and standard deviation of the active channels to arrays of NCh floats
+     *
+     * NaN before the first sample, nullptr is skipped.
+     */
+    void getStatistics(float* mean, float* stdDev) const;
+};
+
+
+template <uint32_t NCh>
+double ExponentialStatistics<NCh>::alphaFor(const uint64_t &timeConstantUs, const uint32_t &periodUs)
+{
+    if(timeConstantUs == 0)
+    {
+        return 1;
+    }
+    return -expm1(-static_cast<double>(periodUs) / timeConstantUs);
+}
+
+
+template <uint32_t NCh>
+void ExponentialStatistics<NCh>::setTimeConstant(const uint64_t &timeConstantUs, const uint32_t &periodUs)
+{
+    // exp is expensive without FPU, only on change
+    if(timeConstantUs == this->timeConstantUs && periodUs == this->periodUs)
+    {
+        return;
+    }
+    this->timeConstantUs = timeConstantUs;
+    this->periodUs = periodUs;
+    alpha = alphaFor(timeConstantUs, periodUs);
+}
+
+
+template <uint32_t NCh>
+void ExponentialStatistics<NCh>::setChannelMask(const uint8_t &mask)
+{
+    channelMask = mask & ((1u << NCh) - 1);
+    clear();
+}
+
+
+template <uint32_t NCh>
+void ExponentialStatistics<NCh>::insert(const float* el)
+{
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!(channelMask & (1u << ch)))
+        {
+            continue;
+        }
+
+        if(!started)
+        {
+            mean[ch] = el[ch];
+            variance[ch] = 0;
+            continue;
+        }
+
+        // incremental exponentially weighted mean and variance
+        const double diff = el[ch] - mean[ch];
+        const double increment = alpha * diff;
+        mean[ch] += increment;
+        variance[ch] = (1 - alpha) * (variance[ch] + diff * increment);
+    }
+    started = true;
+}
+
+
+template <uint32_t NCh>
+void ExponentialStatistics<NCh>::getStatistics(float* mean, float* stdDev) const
+{
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!(channelMask & (1u << ch)))
+        {
+            continue;
+        }
+        if(mean != nullptr) mean[ch] = started ? this->mean[ch] : NAN;
+        if(stdDev != nullptr) stdDev[ch] = started ? sqrt(variance[ch]) : NAN;
+    }
+}
+
+
+} // namespace Xerxes
+
+#endif // !EXPONENTIAL_STATISTICS_HPP
@@ -0,0 +1,138 @@
+#ifndef HAMPEL_FILTER_HPP
+#define HAMPEL_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Streaming Hampel filter of NCh channels sampled together
+ *
+ * Every channel keeps its last K raw samples. A new sample further than
+ * threshold * 1.4826 * MAD (median absolute deviation, 1.4826 * MAD estimates
+ * the standard deviation of normal noise) from the median of the last K
+ * samples is an outlier and it is replaced by the median. Outliers stay in
+ * the window of raw samples, median and MAD do not see them anyway.
+ *
+ * Each sample takes two nth_element over K elements, the time per sample is
+ * bounded by K and does not depend on the signal. Nothing is replaced until
+ * K samples were seen, and a window of equal values (MAD = 0) has no spread to
+ * judge by, so nothing is replaced then either.
+ *
+ * @tparam NCh - number of channels, 1..8
+ * @tparam T - type of the samples
+ * @tparam K - window length, odd
+ */
+template <uint32_t NCh, class T, uint32_t K>
+class HampelFilter
+{
+    static_assert(NCh > 0 && NCh <= 8, "channel mask is 8 bits");
+    static_assert(K >= 3 && K % 2 == 1, "window must be odd to have a middle element");
+
+protected:
+    constexpr static float MAD_TO_SIGMA = 1.4826f;
+
+    uint8_t channelMask {(1u << NCh) - 1};
+    float threshold {3};            ///< outlier distance from the median in standard deviations
+
+    uint32_t pos {0};               ///< next position to write, shared by all channels
+    uint32_t count {0};             ///< samples in the window, up to K
+    std::array<std::array<T, K>, NCh> recent {};    ///< last K raw samples of each channel
+
+public:
+    HampelFilter() = default;
+
+    /// @brief Outlier distance from the median in standard deviations, default 3
+    void setThreshold(const float &threshold) { this->threshold = threshold; }
+
+    /// @brief Select channels to filter, drops the window
+    void setChannelMask(const uint8_t &mask);
+
+    /// @brief Drop the window, nothing is replaced until it is full again
+    void clear();
+
+    /**
+     * @brief Replace outliers in one sample of all channels with the median of their window
+     *
+     * @param el - NCh consecutive samples, el[i] belongs to channel i, replaced in place
+     * @return bit i set if channel i was an outlier
+     */
+    uint8_t filter(T* el);
+};
+
+
+template <uint32_t NCh, class T, uint32_t K>
+void HampelFilter<NCh, T, K>::setChannelMask(const uint8_t &mask)
+{
+    channelMask = mask & ((1u << NCh) - 1);
+    clear();
+}
+
+
+template <uint32_t NCh, class T, uint32_t K>
+void HampelFilter<NCh, T, K>::clear()
+{
+    pos = 0;
+    count = 0;
+}
+
+
+template <uint32_t NCh, class T, uint32_t K>
+uint8_t HampelFilter<NCh, T, K>::filter(T* el)
+{
+    uint8_t outliers = 0;
+    if(count < K)
+    {
+        count++;
+    }
+
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!(channelMask & (1u << ch)))
+        {
+            continue;
+        }
+
+        // NaN is passed on, the slot keeps its older sample so the ordering stays valid
+        if(el[ch] == el[ch])
+        {
+            recent[ch][pos] = el[ch];
+        }
+        if(count < K || el[ch] != el[ch])
+        {
+            continue;
+        }
+
+        std::array<T, K> sorted = recent[ch];
+        std::nth_element(sorted.begin(), sorted.begin() + K / 2, sorted.end());
+        const T median = sorted[K / 2];
+
+        std::array<float, K> deviations;
+        for(uint32_t i = 0; i < K; i++)
+        {
+            deviations[i] = fabsf(static_cast<float>(sorted[i]) - static_cast<float>(median));
+        }
+        std::nth_element(deviations.begin(), deviations.begin() + K / 2, deviations.end());
+        const float mad = deviations[K / 2];
+
+        const float distance = fabsf(static_cast<float>(el[ch]) - static_cast<float>(median));
+        if(mad > 0 && distance > threshold * MAD_TO_SIGMA * mad)
+        {
+            el[ch] = median;
+            outliers |= 1u << ch;
+        }
+    }
+
+    pos = pos + 1 < K ? pos + 1 : 0;
+    return outliers;
+}
+
+
+} // namespace Xerxes
+
+#endif // !HAMPEL_FILTER_HPP
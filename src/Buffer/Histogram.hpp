@@ -0,0 +1,114 @@
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Online histogram with NBins fixed buckets
+ *
+ * Bucket i counts samples in [min + i * width, min + (i + 1) * width),
+ * samples below and above the range are counted separately, NaNs are not
+ * counted. Insert is O(1) - one multiply to find the bucket, no search - and
+ * counts accumulate until clear() or setRange().
+ *
+ * @tparam NBins - number of buckets
+ */
+template <uint32_t NBins>
+class Histogram
+{
+protected:
+    float min {0};
+    float width {0};        ///< width of a bucket as set
+    float invWidth {0};     ///< 1 / width, 0 when disabled
+
+    std::array<uint32_t, NBins> bins {};
+    uint32_t underflow {0};
+    uint32_t overflow {0};
+
+public:
+    Histogram() = default;
+
+    /**
+     * @brief Set buckets and drop all counts
+     *
+     * @param min - lower edge of the first bucket
+     * @param width - width of a bucket, histogram is disabled unless finite and > 0
+     */
+    void setRange(const float &min, const float &width);
+
+    /// @brief Histogram counts samples
+    bool enabled() const { return invWidth > 0; }
+
+    /// @brief Range was set with exactly these values, NaN included
+    bool hasRange(const float &min, const float &width) const
+    {
+        return std::memcmp(&min, &this->min, sizeof(float)) == 0 &&
+               std::memcmp(&width, &this->width, sizeof(float)) == 0;
+    }
+
+    /// @brief Drop all counts
+    void clear();
+
+    /// @brief Count sample in its bucket
+    void insert(const float &el);
+
+    const std::array<uint32_t, NBins> & getBins() const { return bins; }
+    const uint32_t & getUnderflow() const { return underflow; }
+    const uint32_t & getOverflow() const { return overflow; }
+};
+
+
+template <uint32_t NBins>
+void Histogram<NBins>::setRange(const float &min, const float &width)
+{
+    const bool valid = std::isfinite(min) && std::isfinite(width) && width > 0;
+    this->min = min;
+    this->width = width;
+    invWidth = valid ? 1 / width : 0;
+    clear();
+}
+
+
+template <uint32_t NBins>
+void Histogram<NBins>::clear()
+{
+    bins.fill(0);
+    underflow = 0;
+    overflow = 0;
+}
+
+
+template <uint32_t NBins>
+void Histogram<NBins>::insert(const float &el)
+{
+    if(!enabled() || el != el)
+    {
+        return;
+    }
+
+    const float pos = (el - min) * invWidth;
+    if(pos < 0)
+    {
+        underflow++;
+    }
+    else if(pos >= NBins)
+    {
+        overflow++;
+    }
+    else
+    {
+        bins[static_cast<uint32_t>(pos)]++;
+    }
+}
+
+
+} // namespace Xerxes
+
+#endif // !HISTOGRAM_HPP
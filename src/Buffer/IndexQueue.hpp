@@ -0,0 +1,61 @@
+#ifndef INDEX_QUEUE_HPP
+#define INDEX_QUEUE_HPP
+
+#include <cstdint>
+#include "Storage.hpp"
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Double ended queue of buffer positions with fixed capacity
+ *
+ * Used by StatisticBuffer to keep monotonic queues of ring positions for
+ * sliding window min/max. Storage is allocated once (see Storage), push and
+ * pop never allocate.
+ *
+ * @tparam N - capacity of the fixed variant, 0 for capacity given at runtime
+ */
+template <uint32_t N = 0>
+class IndexQueue
+{
+protected:
+    Storage<uint32_t, N> idx;
+    uint32_t capacity {N};
+    uint32_t head {0};
+    uint32_t count {0};
+
+public:
+    IndexQueue() = default;
+    IndexQueue(const uint32_t &capacity) : idx(capacity), capacity(Storage<uint32_t, N>::fit(capacity)) {};
+
+    bool empty() const { return count == 0; }
+
+    void clear() { head = 0; count = 0; }
+
+    /// @brief oldest position in the queue, queue must not be empty
+    uint32_t front() const { return idx[head]; }
+
+    /// @brief newest position in the queue, queue must not be empty
+    uint32_t back() const { return idx[(head + count - 1) % capacity]; }
+
+    void pushBack(const uint32_t &pos)
+    {
+        idx[(head + count) % capacity] = pos;
+        count++;
+    }
+
+    void popFront()
+    {
+        head = (head + 1) % capacity;
+        count--;
+    }
+
+    void popBack() { count--; }
+};
+
+
+} // namespace Xerxes
+
+#endif // !INDEX_QUEUE_HPP
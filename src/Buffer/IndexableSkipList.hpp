@@ -0,0 +1,255 @@
+#ifndef INDEXABLE_SKIP_LIST_HPP
+#define INDEXABLE_SKIP_LIST_HPP
+
+#include <cstdint>
+#include "Storage.hpp"
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Indexable skip list over the positions of a ring buffer
+ *
+ * Keeps positions of the ring sorted by the value stored at them, so the k-th
+ * smallest element of the window is found in O(log N) - this is what makes
+ * median and percentiles possible without sorting the window on every sample.
+ *
+ * Nodes are the ring positions themselves, all storage is allocated once in
+ * the constructor (see Storage) and insert/remove never allocate. The level of a node is
+ * derived from its position (1 + trailing zeros of pos + 1), which gives the
+ * usual 1/2 geometric distribution of levels without a random generator and
+ * ~2N links in total. Ties are broken by position, NaNs sort above everything.
+ *
+ * Values are not owned by the list, the storage of the ring is passed to every
+ * call which compares them, so copies of the ring keep working with their own
+ * copy of the list. Value at a position must not change while the position is
+ * in the list: remove it before the ring overwrites it, insert it afterwards.
+ *
+ * @tparam T - type of the elements of the ring buffer
+ * @tparam N - capacity of the fixed variant, 0 for capacity given at runtime
+ */
+template <class T, uint32_t N = 0>
+class IndexableSkipList
+{
+protected:
+    constexpr static uint32_t MAX_LEVELS = 32;
+
+    /// @brief number of levels of the head, 2^levels > capacity
+    constexpr static uint32_t levelsFor(const uint32_t &capacity)
+    {
+        uint32_t levels = 1;
+        while(levels < MAX_LEVELS && (1u << levels) <= capacity)
+        {
+            levels++;
+        }
+        return levels;
+    }
+
+    /// @brief number of levels of the node, head is node [capacity]
+    constexpr static uint32_t levelOf(const uint32_t &node, const uint32_t &capacity)
+    {
+        const uint32_t levels = levelsFor(capacity);
+        if(node == capacity) return levels;
+        uint32_t level = 1 + __builtin_ctz(node + 1);
+        return level < levels ? level : levels;
+    }
+
+    /// @brief total number of links of all nodes including the head
+    constexpr static uint32_t linksFor(const uint32_t &capacity)
+    {
+        uint32_t links = 0;
+        for(uint32_t node = 0; node <= capacity; node++)
+        {
+            links += levelOf(node, capacity);
+        }
+        return links;
+    }
+
+    uint32_t capacity {N};      ///< number of ring positions, head is node [capacity]
+    uint32_t nil {N + 1};       ///< end of list marker
+    uint32_t levels {levelsFor(N)};  ///< number of levels of the head
+    uint32_t count {0};
+
+    Storage<uint32_t, N ? N + 2 : 0> linkOffset;    ///< first link of the node in next/width
+    Storage<uint32_t, N ? linksFor(N) : 0> next;    ///< next node on the level
+    Storage<uint32_t, N ? linksFor(N) : 0> width;   ///< number of level 0 steps to the next node
+
+    uint32_t levelOf(const uint32_t &node) const
+    {
+        if(node == capacity) return levels;
+        uint32_t level = 1 + __builtin_ctz(node + 1);
+        return level < levels ? level : levels;
+    }
+
+    /// @brief strict weak ordering of positions by value, then position
+    static bool less(const T* values, const uint32_t &a, const uint32_t &b)
+    {
+        const T va = values[a];
+        const T vb = values[b];
+        if(va < vb) return true;
+        if(vb < va) return false;
+
+        // equal or at least one NaN
+        const bool nanA = va != va;
+        const bool nanB = vb != vb;
+        if(nanA != nanB) return nanB;
+        return a < b;
+    }
+
+public:
+    IndexableSkipList() : IndexableSkipList(N) {};
+
+    /**
+     * @brief Construct a new empty list for a ring of given capacity
+     *
+     * @param capacity - number of elements of the ring buffer, at most N for the fixed variant
+     */
+    IndexableSkipList(const uint32_t &capacity);
+
+    /// @brief Number of positions in the list
+    uint32_t size() const { return count; }
+
+    /// @brief Remove all positions
+    void clear();
+
+    /// @brief Insert position, values[pos] is the sorting key
+    void insert(const T* values, const uint32_t &pos);
+
+    /// @brief Remove position, must be in the list and values[pos] unchanged
+    void remove(const T* values, const uint32_t &pos);
+
+    /// @brief Position of the element with given rank, 0 is the smallest
+    uint32_t at(uint32_t rank) const;
+};
+
+
+template <class T, uint32_t N>
+IndexableSkipList<T, N>::IndexableSkipList(const uint32_t &capacity)
+    : capacity(Storage<uint32_t, N>::fit(capacity)), nil(this->capacity + 1), levels(levelsFor(this->capacity)), 
+      linkOffset(this->capacity + 2), next(linksFor(this->capacity)), width(linksFor(this->capacity))
+{
+    // nodes 0..capacity-1 are ring positions, node capacity is the head
+    uint32_t links = 0;
+    for(uint32_t node = 0; node <= this->capacity; node++)
+    {
+        linkOffset[node] = links;
+        links += levelOf(node);
+    }
+    linkOffset[this->capacity + 1] = links;
+
+    clear();
+}
+
+
+template <class T, uint32_t N>
+void IndexableSkipList<T, N>::clear()
+{
+    for(uint32_t lvl = 0; lvl < levels; lvl++)
+    {
+        next[linkOffset[capacity] + lvl] = nil;
+        width[linkOffset[capacity] + lvl] = 1;
+    }
+    count = 0;
+}
+
+
+template <class T, uint32_t N>
+void IndexableSkipList<T, N>::insert(const T* values, const uint32_t &pos)
+{
+    uint32_t chain[MAX_LEVELS];
+    uint32_t stepsAtLevel[MAX_LEVELS];
+
+    uint32_t node = capacity;
+    for(uint32_t lvl = levels; lvl-- > 0;)
+    {
+        stepsAtLevel[lvl] = 0;
+        uint32_t link = linkOffset[node] + lvl;
+        while(next[link] != nil && less(values, next[link], pos))
+        {
+            stepsAtLevel[lvl] += width[link];
+            node = next[link];
+            link = linkOffset[node] + lvl;
+        }
+        chain[lvl] = node;
+    }
+
+    const uint32_t nodeLevels = levelOf(pos);
+    uint32_t steps = 0;
+    for(uint32_t lvl = 0; lvl < nodeLevels; lvl++)
+    {
+        const uint32_t prevLink = linkOffset[chain[lvl]] + lvl;
+        const uint32_t newLink = linkOffset[pos] + lvl;
+        next[newLink] = next[prevLink];
+        next[prevLink] = pos;
+        width[newLink] = width[prevLink] - steps;
+        width[prevLink] = steps + 1;
+        steps += stepsAtLevel[lvl];
+    }
+
+    for(uint32_t lvl = nodeLevels; lvl < levels; lvl++)
+    {
+        width[linkOffset[chain[lvl]] + lvl]++;
+    }
+
+    count++;
+}
+
+
+template <class T, uint32_t N>
+void IndexableSkipList<T, N>::remove(const T* values, const uint32_t &pos)
+{
+    uint32_t chain[MAX_LEVELS];
+
+    uint32_t node = capacity;
+    for(uint32_t lvl = levels; lvl-- > 0;)
+    {
+        uint32_t link = linkOffset[node] + lvl;
+        while(next[link] != nil && less(values, next[link], pos))
+        {
+            node = next[link];
+            link = linkOffset[node] + lvl;
+        }
+        chain[lvl] = node;
+    }
+
+    const uint32_t nodeLevels = levelOf(pos);
+    for(uint32_t lvl = 0; lvl < nodeLevels; lvl++)
+    {
+        const uint32_t prevLink = linkOffset[chain[lvl]] + lvl;
+        const uint32_t oldLink = linkOffset[pos] + lvl;
+        width[prevLink] += width[oldLink] - 1;
+        next[prevLink] = next[oldLink];
+    }
+
+    for(uint32_t lvl = nodeLevels; lvl < levels; lvl++)
+    {
+        width[linkOffset[chain[lvl]] + lvl]--;
+    }
+
+    count--;
+}
+
+
+template <class T, uint32_t N>
+uint32_t IndexableSkipList<T, N>::at(uint32_t rank) const
+{
+    uint32_t node = capacity;
+    rank++;
+    for(uint32_t lvl = levels; lvl-- > 0;)
+    {
+        uint32_t link = linkOffset[node] + lvl;
+        while(next[link] != nil && width[link] <= rank)
+        {
+            rank -= width[link];
+            node = next[link];
+            link = linkOffset[node] + lvl;
+        }
+    }
+    return node;
+}
+
+
+} // namespace Xerxes
+
+#endif // !INDEXABLE_SKIP_LIST_HPP
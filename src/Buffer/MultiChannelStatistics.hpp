@@ -0,0 +1,711 @@
+#ifndef MULTI_CHANNEL_STATISTICS_HPP
+#define MULTI_CHANNEL_STATISTICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "IndexQueue.hpp"
+#include "IndexableSkipList.hpp"
+#include "StatisticMath.hpp"
+
+namespace Xerxes
+{
+
+
+/// @brief Order statistics kept by MultiChannelStatistics on request, see its Order parameter
+enum OrderStatistics : uint8_t
+{
+    ORDER_NONE = 0,
+    ORDER_EXTREMES = 1 << 0,        ///< min and max, two monotonic queues per channel
+    ORDER_PERCENTILES = 1 << 1,     ///< median and percentiles, an indexable skip list per channel
+    ORDER_ALL = ORDER_EXTREMES | ORDER_PERCENTILES
+};
+
+
+/**
+ * @brief Streaming statistics of NCh channels sampled together
+ *
+ * Same statistics as StatisticBuffer (min, max, mean, standard deviation,
+ * median, percentiles) for up to 8 channels which are sampled in the same
+ * cycle, e.g. process values pv0..pv3 of a sensor. One insert() takes a sample
+ * of all channels and updates them in a single loop with one shared ring
+ * cursor.
+ *
+ * Storage is structure of arrays: the window of every channel is a contiguous
+ * array and each running quantity (sums, reference values, results) is an
+ * array indexed by channel, so the loop walks linear memory. Everything is
+ * embedded in the object, nothing is allocated.
+ *
+ * Channels not in the channel mask are skipped by insert() and
+ * updateStatistics() and never written by getStatistics()/getPercentiles(),
+ * which take pointers to NCh consecutive floats - e.g. the MEAN or P5 block of
+ * the register - and write the results straight into them.
+ *
+ * With an integer Sum the sums are exact and published through fixed point
+ * math, see StatisticBuffer.
+ *
+ * Min/max and the percentiles need structures which grow with the window,
+ * they are only kept if requested by Order. Per sample and channel a window
+ * holds the sample itself; min/max add 8 bytes (two queues of 32 bit
+ * positions) and the percentiles about 20 bytes (skip list node), so 4 float
+ * channels cost 20 bytes per sample without and 132 bytes with both, e.g.
+ * 14 kB for N = 100 and 133 kB for N = 1000. Statistics which are not kept
+ * are NaN.
+ *
+ * Every sample carries its timestamp. With a window set in microseconds
+ * (setWindowUs()) samples older than the window are evicted by time on
+ * insert, so the window covers the same time span whatever the cycle time
+ * is - up to N samples, then the oldest are evicted by count as well.
+ * Timestamps are kept as 32 bit microseconds, windows are limited to ~35 min.
+ *
+ * The timestamps also give a least-squares line x = intercept + slope * t of
+ * every channel over the window (getTrend()). It comes from running sums of
+ * t, t^2 and t * x next to the sums of x, added and removed with the samples
+ * and rebuilt every lap like them, so it is O(1) per sample as well. Time
+ * sums are double in seconds relative to a reference time.
+ *
+ * Cross sums of every pair of channels, kept the same way relative to the
+ * shifts of both channels, give the covariance matrix over the window
+ * (getCovariance()). A pair is summed only while both channels are active.
+ *
+ * @tparam NCh - number of channels, 1..8
+ * @tparam T - type of the samples
+ * @tparam N - length of the window in samples, upper bound of the time window
+ * @tparam Sum - type of the running sums, integer only for integer T
+ * @tparam Order - OrderStatistics to keep, ORDER_NONE for the sums only
+ */
+template <uint32_t NCh, class T, uint32_t N, class Sum = double, uint8_t Order = ORDER_NONE>
+class MultiChannelStatistics
+{
+    static_assert(NCh > 0 && NCh <= 8, "channel mask is 8 bits");
+    static_assert(N > 0, "window must be fixed at compile time");
+    static_assert(std::is_floating_point_v<Sum> || std::is_integral_v<T>,
+                  "integer sums need integer elements");
+
+public:
+    using Element = T;                                              ///< type of the samples
+    constexpr static uint32_t Channels = NCh;                       ///< number of channels
+    constexpr static uint32_t NPairs = NCh * (NCh - 1) / 2;         ///< channel pairs with a cross sum
+    constexpr static uint32_t NCovariances = NCh * (NCh + 1) / 2;   ///< upper triangle of the covariance matrix
+    constexpr static bool KeepsExtremes = Order & ORDER_EXTREMES;       ///< min and max are kept
+    constexpr static bool KeepsPercentiles = Order & ORDER_PERCENTILES; ///< median and percentiles are kept
+
+protected:
+    /// @brief Stand-in for order statistics which are not kept, takes no storage
+    struct NotKept {};
+
+    template <bool Keep, class Kept>
+    using Optional = std::conditional_t<Keep, Kept, NotKept>;
+
+    uint8_t channelMask {(1u << NCh) - 1};
+
+    uint32_t currentPos {0};    ///< next position to write, shared by all channels
+    uint32_t count {0};         ///< number of samples in the window
+    uint32_t windowUs {0};      ///< length of the window in time, 0 for N samples
+
+    std::array<std::array<T, N>, NCh> samples {};   ///< window of each channel
+    std::array<uint32_t, N> timestamps {};          ///< time of the sample at the position, shared by all channels
+
+    std::array<Sum, NCh> shift {};      ///< reference value the running sums are relative to
+    std::array<Sum, NCh> sum {};        ///< sum of (el - shift) over the window
+    std::array<Sum, NCh> sumSq {};      ///< sum of (el - shift)^2 over the window
+    std::array<Sum, NCh> nextShift {};  ///< reference value of the sums of the current lap
+    std::array<Sum, NCh> nextSum {};    ///< sum of (el - nextShift) inserted since the ring wrapped
+    std::array<Sum, NCh> nextSumSq {};  ///< sum of (el - nextShift)^2 inserted since the ring wrapped
+
+    uint32_t timeShift {0};             ///< reference time of the time sums
+    double sumT {0};                    ///< sum of (t - timeShift) in s over the window
+    double sumTSq {0};                  ///< sum of (t - timeShift)^2 over the window
+    std::array<double, NCh> sumTX {};   ///< sum of (t - timeShift) * (el - shift) over the window
+    uint32_t nextTimeShift {0};         ///< reference time of the time sums of the current lap
+    double nextSumT {0};                ///< sum of (t - nextTimeShift) inserted since the ring wrapped
+    double nextSumTSq {0};              ///< sum of (t - nextTimeShift)^2 inserted since the ring wrapped
+    std::array<double, NCh> nextSumTX {};   ///< sum of (t - nextTimeShift) * (el - nextShift) inserted since the ring wrapped
+
+    std::array<Sum, NPairs> sumXY {};       ///< sum of (x - shift) * (y - shift) over the window, pairs x < y in pair() order
+    std::array<Sum, NPairs> nextSumXY {};   ///< sum of (x - nextShift) * (y - nextShift) inserted since the ring wrapped
+
+    /// @brief positions of increasing elements, front is the minimum
+    [[no_unique_address]] Optional<KeepsExtremes, std::array<IndexQueue<N>, NCh>> minQueue;
+    /// @brief positions of decreasing elements, front is the maximum
+    [[no_unique_address]] Optional<KeepsExtremes, std::array<IndexQueue<N>, NCh>> maxQueue;
+    /// @brief positions sorted by value
+    [[no_unique_address]] Optional<KeepsPercentiles, std::array<IndexableSkipList<T, N>, NCh>> order;
+
+    std::array<float, NCh> min {};
+    std::array<float, NCh> max {};
+    std::array<float, NCh> mean {};
+    std::array<float, NCh> stdDev {};
+    std::array<float, NCh> median {};
+    std::array<float, NCh> lowPercentile {};
+    std::array<float, NCh> highPercentile {};
+    std::array<float, NCh> slope {};        ///< per second
+    std::array<float, NCh> intercept {};    ///< value of the line at the newest sample
+    std::array<float, NCovariances> covariance {};  ///< upper triangle row by row
+
+    float lowPercent {5};   ///< percent of the low percentile, e.g. 5 for p5
+    float highPercent {95}; ///< percent of the high percentile, e.g. 95 for p95
+
+    float scale {1};        ///< published = scale * statistic + offset
+    float offset {0};
+
+    bool active(const uint32_t &ch) const { return channelMask & (1u << ch); }
+
+    /// @brief Index of the cross sum of channels x < y, pairs are ordered (0, 1), (0, 2) ... (1, 2) ...
+    static constexpr uint32_t pair(const uint32_t &x, const uint32_t &y)
+    {
+        return x * (2 * NCh - x - 1) / 2 + (y - x - 1);
+    }
+
+    /// @brief Index of the covariance of channels x <= y in the upper triangle, row by row
+    static constexpr uint32_t triangle(const uint32_t &x, const uint32_t &y)
+    {
+        return x * (2 * NCh - x + 1) / 2 + (y - x);
+    }
+
+    /// @brief Push position of the newest element of the channel to its min/max queues
+    void pushExtremes(const uint32_t &ch, const uint32_t &pos);
+
+    /// @brief Remove the oldest sample of all channels from the window
+    void evictOldest();
+
+    /// @brief Time from the reference to the timestamp in seconds, negative for samples before it
+    static double seconds(const uint32_t &timestamp, const uint32_t &reference)
+    {
+        return static_cast<int32_t>(timestamp - reference) * 1e-6;
+    }
+
+public:
+    MultiChannelStatistics() = default;
+
+    /**
+     * @brief Select channels to process, drops all samples
+     *
+     * @param mask - bit i set for channel i
+     */
+    void setChannelMask(const uint8_t &mask);
+
+    const uint8_t & getChannelMask() const { return channelMask; }
+
+    /// @brief Number of samples in the window
+    uint32_t size() const { return count; }
+
+    /**
+     * @brief Set length of the window in time, takes effect on the next insert
+     *
+     * @param windowUs - window in microseconds, at most 2^31 - 1, 0 for a window of N samples
+     */
+    void setWindowUs(const uint32_t &windowUs);
+
+    const uint32_t & getWindowUs() const { return windowUs; }
+
+    /// @brief Drop all samples
+    void clear();
+
+    /**
+     * @brief Insert one sample of all channels, evict samples which left the window
+     *
+     * @param el - NCh consecutive samples, el[i] belongs to channel i
+     * @param timeUs - time of the sample in microseconds, must not decrease
+     */
+    void insert(const T* el, const uint64_t &timeUs = 0);
+
+    /// @brief Compute statistics of the active channels
+    void updateStatistics();
+
+    /// @brief Set percentiles computed by updateStatistics(), default p5 and p95
+    void setPercentiles(const float &lowPercent, const float &highPercent);
+
+    /// @brief Publish statistics as scale * value + offset, see StatisticBuffer::setScale()
+    void setScale(const float &scale, const float &offset = 0);
+
+    /**
+     * @brief Copy statistics of the active channels to arrays of NCh floats, nullptr is skipped
+     */
+    void getStatistics(float* min,
+                       float* max,
+                       float* mean,
+                       float* stdDev,
+                       float* median = nullptr) const;
+
+    /**
+     * @brief Copy percentiles of the active channels to arrays of NCh floats, nullptr is skipped
+     *
+     * @param low - low percentile (p5 by default)
+     * @param median - p50
+     * @param high - high percentile (p95 by default)
+     */
+    void getPercentiles(float* low, float* median, float* high) const;
+
+    /**
+     * @brief Copy least-squares line of the active channels to arrays of NCh floats, nullptr is skipped
+     *
+     * NaN until the window holds samples at two different times.
+     *
+     * @param slope - change per timeUnitS, e.g. 3600 for change per hour
+     * @param intercept - value of the line at the time of the newest sample
+     * @param timeUnitS - time unit of the slope in seconds
+     */
+    void getTrend(float* slope, float* intercept, const float &timeUnitS = 1) const;
+
+    /**
+     * @brief Copy covariance matrix of the window to an array of NCovariances floats
+     *
+     * Upper triangle row by row, for 4 channels c00 c01 c02 c03 c11 c12 c13
+     * c22 c23 c33 - the diagonal is the variance. Population covariance like
+     * the standard deviation, scaled by scale^2. Entries of an inactive
+     * channel are not written, NaN for an empty window.
+     */
+    void getCovariance(float* covariance) const;
+};
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::setChannelMask(const uint8_t &mask)
+{
+    channelMask = mask & ((1u << NCh) - 1);
+    clear();
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::setWindowUs(const uint32_t &windowUs)
+{
+    this->windowUs = std::min<uint32_t>(windowUs, INT32_MAX);
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::clear()
+{
+    currentPos = 0;
+    count = 0;
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        sum[ch] = 0;
+        sumSq[ch] = 0;
+        sumTX[ch] = 0;
+        if constexpr(KeepsExtremes)
+        {
+            minQueue[ch].clear();
+            maxQueue[ch].clear();
+        }
+        if constexpr(KeepsPercentiles)
+        {
+            order[ch].clear();
+        }
+    }
+    sumXY.fill(0);
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::pushExtremes(const uint32_t &ch, const uint32_t &pos)
+{
+    const T* values = samples[ch].data();
+    const T el = values[pos];
+
+    // drop elements which can not become extremes while the new one is in the window
+    while(!minQueue[ch].empty() && values[minQueue[ch].back()] >= el)
+    {
+        minQueue[ch].popBack();
+    }
+    minQueue[ch].pushBack(pos);
+
+    while(!maxQueue[ch].empty() && values[maxQueue[ch].back()] <= el)
+    {
+        maxQueue[ch].popBack();
+    }
+    maxQueue[ch].pushBack(pos);
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::evictOldest()
+{
+    const uint32_t pos = (currentPos + N - count) % N;
+
+    // positions below the cursor were written in the current lap
+    const bool currentLap = pos < currentPos;
+
+    const double t = seconds(timestamps[pos], timeShift);
+    const double nextT = seconds(timestamps[pos], nextTimeShift);
+    sumT -= t;
+    sumTSq -= t * t;
+    if(currentLap)
+    {
+        nextSumT -= nextT;
+        nextSumTSq -= nextT * nextT;
+    }
+
+    std::array<Sum, NCh> dev {};
+    std::array<Sum, NCh> nextDev {};
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!active(ch))
+        {
+            continue;
+        }
+        const T* values = samples[ch].data();
+
+        dev[ch] = values[pos] - shift[ch];
+        sum[ch] -= dev[ch];
+        sumSq[ch] -= dev[ch] * dev[ch];
+        sumTX[ch] -= t * static_cast<double>(dev[ch]);
+
+        if(currentLap)
+        {
+            nextDev[ch] = values[pos] - nextShift[ch];
+            nextSum[ch] -= nextDev[ch];
+            nextSumSq[ch] -= nextDev[ch] * nextDev[ch];
+            nextSumTX[ch] -= nextT * static_cast<double>(nextDev[ch]);
+        }
+
+        // evicted element is the oldest, if it is still queued it is at the front
+        if constexpr(KeepsExtremes)
+        {
+            if(!minQueue[ch].empty() && minQueue[ch].front() == pos)
+            {
+                minQueue[ch].popFront();
+            }
+            if(!maxQueue[ch].empty() && maxQueue[ch].front() == pos)
+            {
+                maxQueue[ch].popFront();
+            }
+        }
+        if constexpr(KeepsPercentiles)
+        {
+            order[ch].remove(values, pos);
+        }
+    }
+
+    // deviations of inactive channels are 0, their cross sums stay 0
+    for(uint32_t x = 0; x < NCh; x++)
+    {
+        for(uint32_t y = x + 1; y < NCh; y++)
+        {
+            sumXY[pair(x, y)] -= dev[x] * dev[y];
+            if(currentLap)
+            {
+                nextSumXY[pair(x, y)] -= nextDev[x] * nextDev[y];
+            }
+        }
+    }
+    count--;
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::insert(const T* el, const uint64_t &timeUs)
+{
+    // wraps every ~71 min, differences stay right for windows below half of that
+    const uint32_t now = static_cast<uint32_t>(timeUs);
+
+    while(windowUs > 0 && count > 0 && now - timestamps[(currentPos + N - count) % N] >= windowUs)
+    {
+        evictOldest();
+    }
+    if(count == N)
+    {
+        evictOldest();
+    }
+
+    const uint32_t pos = currentPos;
+    if(count == 0)
+    {
+        timeShift = now;
+        nextTimeShift = now;
+        sumT = 0;
+        sumTSq = 0;
+        nextSumT = 0;
+        nextSumTSq = 0;
+    }
+    else if(pos == 0)
+    {
+        nextTimeShift = now;
+        nextSumT = 0;
+        nextSumTSq = 0;
+    }
+    const double t = seconds(now, timeShift);
+    const double nextT = seconds(now, nextTimeShift);
+    sumT += t;
+    sumTSq += t * t;
+    nextSumT += nextT;
+    nextSumTSq += nextT * nextT;
+
+    if(count == 0)
+    {
+        sumXY.fill(0);
+        nextSumXY.fill(0);
+    }
+    else if(pos == 0)
+    {
+        nextSumXY.fill(0);
+    }
+
+    std::array<Sum, NCh> dev {};
+    std::array<Sum, NCh> nextDev {};
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!active(ch))
+        {
+            continue;
+        }
+        T* values = samples[ch].data();
+
+        if(count == 0)
+        {
+            // empty window, start over relative to the new element
+            shift[ch] = el[ch];
+            nextShift[ch] = el[ch];
+            sum[ch] = 0;
+            sumSq[ch] = 0;
+            sumTX[ch] = 0;
+            nextSum[ch] = 0;
+            nextSumSq[ch] = 0;
+            nextSumTX[ch] = 0;
+        }
+        else if(pos == 0)
+        {
+            // ring wraps around, start new lap relative to the current mean
+            nextShift[ch] = shift[ch] + sum[ch] / static_cast<Sum>(count);
+            nextSum[ch] = 0;
+            nextSumSq[ch] = 0;
+            nextSumTX[ch] = 0;
+        }
+
+        values[pos] = el[ch];
+        if constexpr(KeepsExtremes)
+        {
+            pushExtremes(ch, pos);
+        }
+        if constexpr(KeepsPercentiles)
+        {
+            order[ch].insert(values, pos);
+        }
+
+        dev[ch] = el[ch] - shift[ch];
+        sum[ch] += dev[ch];
+        sumSq[ch] += dev[ch] * dev[ch];
+        sumTX[ch] += t * static_cast<double>(dev[ch]);
+
+        nextDev[ch] = el[ch] - nextShift[ch];
+        nextSum[ch] += nextDev[ch];
+        nextSumSq[ch] += nextDev[ch] * nextDev[ch];
+        nextSumTX[ch] += nextT * static_cast<double>(nextDev[ch]);
+
+        // lap finished, the whole window was written in this lap - drop the drifted sums
+        if(pos == N - 1)
+        {
+            shift[ch] = nextShift[ch];
+            sum[ch] = nextSum[ch];
+            sumSq[ch] = nextSumSq[ch];
+            sumTX[ch] = nextSumTX[ch];
+        }
+    }
+
+    for(uint32_t x = 0; x < NCh; x++)
+    {
+        for(uint32_t y = x + 1; y < NCh; y++)
+        {
+            sumXY[pair(x, y)] += dev[x] * dev[y];
+            nextSumXY[pair(x, y)] += nextDev[x] * nextDev[y];
+        }
+    }
+
+    if(pos == N - 1)
+    {
+        sumXY = nextSumXY;
+        timeShift = nextTimeShift;
+        sumT = nextSumT;
+        sumTSq = nextSumTSq;
+    }
+    timestamps[pos] = now;
+    currentPos = pos + 1 < N ? pos + 1 : 0;
+    count++;
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::updateStatistics()
+{
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!active(ch))
+        {
+            continue;
+        }
+        const T* values = samples[ch].data();
+
+        if constexpr(KeepsExtremes)
+        {
+            min[ch] = minQueue[ch].empty() ? INFINITY : values[minQueue[ch].front()];
+            max[ch] = maxQueue[ch].empty() ? -INFINITY : values[maxQueue[ch].front()];
+        }
+        else
+        {
+            min[ch] = NAN;
+            max[ch] = NAN;
+        }
+        momentsFromSums(shift[ch], sum[ch], sumSq[ch], count, mean[ch], stdDev[ch]);
+
+        // least squares, n^2 * variance of t is 0 for less than two distinct times
+        const double n = count;
+        const double newest = seconds(timestamps[(currentPos + N - 1) % N], timeShift);
+        const double timeSpread = n * sumTSq - sumT * sumT;
+        if(count > 1 && timeSpread > 0)
+        {
+            const double sumX = static_cast<double>(sum[ch]);
+            const double b = (n * sumTX[ch] - sumT * sumX) / timeSpread;
+            slope[ch] = b;
+            intercept[ch] = static_cast<double>(shift[ch]) + (sumX - b * sumT) / n + b * newest;
+        }
+        else
+        {
+            slope[ch] = NAN;
+            intercept[ch] = NAN;
+        }
+
+        if constexpr(KeepsPercentiles)
+        {
+            auto valueAt = [this, ch, values](uint32_t rank) { return values[order[ch].at(rank)]; };
+            median[ch] = interpolatePercentile(50, count, valueAt);
+            lowPercentile[ch] = interpolatePercentile(lowPercent, count, valueAt);
+            highPercentile[ch] = interpolatePercentile(highPercent, count, valueAt);
+        }
+        else
+        {
+            median[ch] = NAN;
+            lowPercentile[ch] = NAN;
+            highPercentile[ch] = NAN;
+        }
+
+        if(scale == 1 && offset == 0)
+        {
+            continue;
+        }
+
+        min[ch] = scale * min[ch] + offset;
+        max[ch] = scale * max[ch] + offset;
+        mean[ch] = scale * mean[ch] + offset;
+        stdDev[ch] = fabsf(scale) * stdDev[ch];
+        median[ch] = scale * median[ch] + offset;
+        lowPercentile[ch] = scale * lowPercentile[ch] + offset;
+        highPercentile[ch] = scale * highPercentile[ch] + offset;
+        slope[ch] = scale * slope[ch];
+        intercept[ch] = scale * intercept[ch] + offset;
+
+        if(scale < 0)
+        {
+            std::swap(min[ch], max[ch]);
+            std::swap(lowPercentile[ch], highPercentile[ch]);
+        }
+    }
+
+    for(uint32_t x = 0; x < NCh; x++)
+    {
+        for(uint32_t y = x; y < NCh; y++)
+        {
+            if(!active(x) || !active(y))
+            {
+                continue;
+            }
+            const Sum &cross = x == y ? sumSq[x] : sumXY[pair(x, y)];
+            covariance[triangle(x, y)] = scale * scale * covarianceFromSums(sum[x], sum[y], cross, count);
+        }
+    }
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::setPercentiles(const float &lowPercent, const float &highPercent)
+{
+    this->lowPercent = lowPercent;
+    this->highPercent = highPercent;
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::setScale(const float &scale, const float &offset)
+{
+    this->scale = scale;
+    this->offset = offset;
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::getStatistics(float* min,
+                                                           float* max,
+                                                           float* mean,
+                                                           float* stdDev,
+                                                           float* median) const
+{
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!active(ch))
+        {
+            continue;
+        }
+        if(min != nullptr) min[ch] = this->min[ch];
+        if(max != nullptr) max[ch] = this->max[ch];
+        if(mean != nullptr) mean[ch] = this->mean[ch];
+        if(stdDev != nullptr) stdDev[ch] = this->stdDev[ch];
+        if(median != nullptr) median[ch] = this->median[ch];
+    }
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::getPercentiles(float* low, float* median, float* high) const
+{
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!active(ch))
+        {
+            continue;
+        }
+        if(low != nullptr) low[ch] = lowPercentile[ch];
+        if(median != nullptr) median[ch] = this->median[ch];
+        if(high != nullptr) high[ch] = highPercentile[ch];
+    }
+}
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::getTrend(float* slope, float* intercept, const float &timeUnitS) const
+{
+    for(uint32_t ch = 0; ch < NCh; ch++)
+    {
+        if(!active(ch))
+        {
+            continue;
+        }
+        if(slope != nullptr) slope[ch] = this->slope[ch] * timeUnitS;
+        if(intercept != nullptr) intercept[ch] = this->intercept[ch];
+    }
+}
+
+
+
+template <uint32_t NCh, class T, uint32_t N, class Sum, uint8_t Order>
+void MultiChannelStatistics<NCh, T, N, Sum, Order>::getCovariance(float* covariance) const
+{
+    for(uint32_t x = 0; x < NCh; x++)
+    {
+        for(uint32_t y = x; y < NCh; y++)
+        {
+            if(active(x) && active(y))
+            {
+                covariance[triangle(x, y)] = this->covariance[triangle(x, y)];
+            }
+        }
+    }
+}
+
+
+} // namespace Xerxes
+
+#endif // !MULTI_CHANNEL_STATISTICS_HPP
@@ -2,95 +2,223 @@
 #define RINGBUFFER_HPP
 
 #include <array>
+#include <algorithm>
 #include <random>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <span>
+#include "Storage.hpp"
 
 namespace Xerxes
 {
 
 
 /**
- * @brief Ring buffer class 
- * 
+ * @brief Ring buffer class
+ *
  * This class implements a ring buffer. It is used to store the last n elements
  * of a stream of data. The buffer is implemented as a circular buffer.
- * 
+ *
+ * The window can be read in place, oldest first, either as two contiguous
+ * segments (segments()) or with a range-for over the buffer.
+ *
+ * RingBuffer<T, N> keeps the elements in a std::array embedded in the object,
+ * no heap is used. RingBuffer<T> (N = 0) allocates the elements on the heap,
+ * for windows configured at runtime. Both are copied by value.
+ *
  * @tparam T - type of the elements to be stored in the buffer
+ * @tparam N - length of the buffer, 0 for length given to the constructor
  */
-template <class T>
+template <class T, uint32_t N = 0>
 class RingBuffer
 {
-private:
-    uint32_t currentPos {0};
-    uint32_t maxSize;
 protected:
+    uint32_t currentPos {0};
+    uint32_t maxSize {N};
     uint32_t maxCursor {0};
-    T* buffer;
+    Storage<T, N> buffer;
     bool saturated {false};
 
 public:
-    RingBuffer();
+    RingBuffer() = default;
+
+    /**
+     * @brief Construct a new empty Ring Buffer
+     *
+     * @param maxSize - length of the buffer, clamped to N for the fixed variant
+     */
     RingBuffer(const uint32_t &maxSize);
     RingBuffer(std::initializer_list<T> il);
-    ~RingBuffer();
 
     void insertOne(const T el);
+
+    /**
+     * @brief Insert a block of elements, oldest first
+     *
+     * Same content as insertOne() for each element, but the block is copied in
+     * at most two segments - up to the end of the ring and from its start. Only
+     * the last maxSize elements of a longer block are copied.
+     *
+     * @param el - elements to insert
+     * @param count - number of elements
+     */
+    void insertMany(const T* el, size_t count);
+    void insertMany(std::span<const T> els) { insertMany(els.data(), els.size()); }
+
     const T & getLast();
-};
 
+    /// @brief Number of elements in the window
+    uint32_t size() const { return maxCursor; }
+
+    /**
+     * @brief Window in chronological order, as views into the buffer
+     *
+     * first holds the oldest elements, second continues from the start of the
+     * ring and is empty unless the window wraps around. Views are valid until
+     * the next insert.
+     */
+    struct Segments
+    {
+        std::span<const T> first;
+        std::span<const T> second;
+    };
+    Segments segments() const;
 
-template <class T>
-RingBuffer<T>::RingBuffer()
-{
-}
+    /// @brief Forward iterator over the window from the oldest element, no copy
+    class ConstIterator
+    {
+        const T* pos {nullptr};
+        const T* ringBegin {nullptr};
+        const T* ringEnd {nullptr};
+        uint32_t remaining {0};     ///< elements from pos to the end of the window
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() = default;
+        ConstIterator(const T* pos, const T* ringBegin, const T* ringEnd, uint32_t remaining)
+            : pos(pos), ringBegin(ringBegin), ringEnd(ringEnd), remaining(remaining) {}
+
+        reference operator*() const { return *pos; }
+        pointer operator->() const { return pos; }
+
+        ConstIterator& operator++()
+        {
+            if(++pos == ringEnd) pos = ringBegin;
+            remaining--;
+            return *this;
+        }
+        ConstIterator operator++(int) { ConstIterator old = *this; ++*this; return old; }
+
+        bool operator==(const ConstIterator &other) const { return remaining == other.remaining; }
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const { return ConstIterator(); }
+};
 
 
-template <class T>
-RingBuffer<T>::RingBuffer(std::initializer_list<T> il) : currentPos(0)
+template <class T, uint32_t N>
+RingBuffer<T, N>::RingBuffer(std::initializer_list<T> il) : RingBuffer(il.size())
 {
-    size_t size = il.size();
-    maxSize = size;
-    buffer = new T[size]{};
-    int i = 0;
-    for(const auto el : il)
-    {
-        buffer[i++] = el;
-    }
-    maxCursor = size;
+    // fixed variant keeps the last N elements of a longer list
+    std::copy(il.end() - maxSize, il.end(), buffer.get());
+    maxCursor = maxSize;
     saturated = true;
 }
 
 
-template <class T>
-RingBuffer<T>::RingBuffer(const uint32_t &maxSize) : maxSize(maxSize), currentPos(0), maxCursor(0)
-{   
-    this->buffer = new T[maxSize]{0};
+template <class T, uint32_t N>
+RingBuffer<T, N>::RingBuffer(const uint32_t &maxSize)
+    : maxSize(Storage<T, N>::fit(maxSize)), buffer(maxSize)
+{
 }
 
-template <class T>
-RingBuffer<T>::~RingBuffer()
+
+template <class T, uint32_t N>
+void RingBuffer<T, N>::insertOne(const T el)
 {
-    // delete buffer; // TODO: uncomment this line !!!
+    if(currentPos >= maxSize)
+    {
+        currentPos = 0;
+        saturated = true;
+    }
+
+    this->buffer[currentPos++] = el;
+    if(currentPos > maxCursor) maxCursor = currentPos;
 }
 
 
-template <class T>
-void RingBuffer<T>::insertOne(const T el)
+template <class T, uint32_t N>
+void RingBuffer<T, N>::insertMany(const T* el, size_t count)
 {
+    if(count == 0 || maxSize == 0)
+    {
+        return;
+    }
+
     if(currentPos >= maxSize)
     {
         currentPos = 0;
         saturated = true;
     }
 
-    this->buffer[currentPos++] = el;
+    // older elements would be overwritten by the block itself, skip them
+    if(count > maxSize)
+    {
+        currentPos = (currentPos + (count - maxSize)) % maxSize;
+        el += count - maxSize;
+        count = maxSize;
+        saturated = true;
+    }
+
+    const uint32_t first = std::min<size_t>(count, maxSize - currentPos);
+    std::copy(el, el + first, buffer.get() + currentPos);
+    currentPos += first;
+
+    if(count > first)
+    {
+        std::copy(el + first, el + count, buffer.get());
+        currentPos = count - first;
+        saturated = true;
+        maxCursor = maxSize;
+    }
     if(currentPos > maxCursor) maxCursor = currentPos;
 }
 
 
-template <class T>
-const T & RingBuffer<T>::getLast()
+template <class T, uint32_t N>
+typename RingBuffer<T, N>::Segments RingBuffer<T, N>::segments() const
+{
+    const T* data = buffer.get();
+
+    // until the ring is full the window starts at 0, then at the oldest element
+    if(maxCursor < maxSize || maxCursor == 0)
+    {
+        return {std::span<const T>(data, maxCursor), {}};
+    }
+    const uint32_t oldest = currentPos % maxSize;
+    return {std::span<const T>(data + oldest, maxSize - oldest), std::span<const T>(data, oldest)};
+}
+
+
+template <class T, uint32_t N>
+typename RingBuffer<T, N>::ConstIterator RingBuffer<T, N>::begin() const
+{
+    const Segments window = segments();
+    const T* data = buffer.get();
+    return ConstIterator(window.first.data(), data, data + maxSize, maxCursor);
+}
+
+
+template <class T, uint32_t N>
+const T & RingBuffer<T, N>::getLast()
 {
     if(this->currentPos > 0)
     {
@@ -102,7 +230,7 @@ const T & RingBuffer<T>::getLast()
     }
 }
 
-    
+
 } // namespace Xerxes
 
-#endif // RINGBUFFER_HPP
\ No newline at end of file
+#endif // RINGBUFFER_HPP
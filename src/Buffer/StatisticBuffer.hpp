@@ -1,45 +1,438 @@
 #ifndef STATISTIC_BUFFER_HPP
 #define STATISTIC_BUFFER_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "RingBuffer.hpp"
+#include "IndexQueue.hpp"
+#include "IndexableSkipList.hpp"
+#include "StatisticMath.hpp"
 #include "Utils/Log.h"
 
 namespace Xerxes
 {
 
 
-template <class T>
-class StatisticBuffer : public RingBuffer<T>
+/**
+ * @brief Ring buffer with statistics (min, max, mean, standard deviation, median, percentiles)
+ *
+ * In streaming mode (default) mean and standard deviation are kept as running
+ * sums which are updated on every insert - the new element is added, the
+ * evicted one removed - so their cost does not depend on the window length.
+ * The sums are shifted by a reference value close to the mean to avoid
+ * cancellation, and rebuilt from scratch every time the ring wraps around, so
+ * rounding errors can not accumulate over more than one window.
+ *
+ * Min and max are tracked by two monotonic queues of ring positions stored
+ * alongside the buffer - increasing values for min, decreasing for max - so
+ * the extremes of the window are at the front of the queues, amortised O(1)
+ * per insert.
+ *
+ * Median and percentiles are read from an indexable skip list which keeps the
+ * ring positions sorted by value, O(log N) per insert and per percentile.
+ *
+ * With streaming disabled every updateStatistics() rescans and sorts the
+ * whole window.
+ *
+ * StatisticBuffer<T, N> keeps the window and all streaming structures inside
+ * the object, StatisticBuffer<T> allocates them on the heap once, with the
+ * window given to the constructor. Both are copied and moved by value.
+ *
+ * With an integer Sum (e.g. StatisticBuffer<int32_t, N, int64_t> for raw ADC
+ * counts) the running sums are exact integers and insertOne() does no floating
+ * point math at all. Mean is computed in Q16 fixed point and standard deviation
+ * with an integer square root, they are converted to float only when the
+ * statistics are published by updateStatistics(). The sum of squares is the
+ * largest, relative to the reference value shift it stays exact in an int64_t
+ * Sum as long as N * max((el - shift)^2) < 2^63.
+ *
+ * Published statistics can be scaled to engineering units, see setScale().
+ *
+ * @tparam T - type of the elements to be stored in the buffer
+ * @tparam N - length of the window, 0 for length given to the constructor
+ * @tparam Sum - type of the running sums, integer only for integer T
+ */
+template <class T, uint32_t N = 0, class Sum = double>
+class StatisticBuffer : public RingBuffer<T, N>
 {
+    static_assert(std::is_floating_point_v<Sum> || std::is_integral_v<T>, 
+                  "integer sums need integer elements");
+
 protected:
     float min;
     float max;
     float mean;
     float stdDev;
     float median;
+    float lowPercentile;
+    float highPercentile;
+
+    float lowPercent {5};   ///< percent of the low percentile, e.g. 5 for p5
+    float highPercent {95}; ///< percent of the high percentile, e.g. 95 for p95
+
+    float scale {1};        ///< published = scale * statistic + offset
+    float offset {0};
+
+    bool streaming {true};
+
+    Sum shift {0};          ///< reference value the running sums are relative to
+    Sum sum {0};            ///< sum of (el - shift) over the window
+    Sum sumSq {0};          ///< sum of (el - shift)^2 over the window
+
+    Sum nextShift {0};      ///< reference value of the sums of the current lap
+    Sum nextSum {0};        ///< sum of (el - nextShift) inserted since the ring wrapped
+    Sum nextSumSq {0};      ///< sum of (el - nextShift)^2 inserted since the ring wrapped
+
+    IndexQueue<N> minQueue;     ///< positions of increasing elements, front is the minimum
+    IndexQueue<N> maxQueue;     ///< positions of decreasing elements, front is the maximum
+
+    IndexableSkipList<T, N> order;  ///< positions sorted by value for median and percentiles
+
+    /// @brief Push position of the newest element to the min/max queues
+    void pushExtremes(const uint32_t &pos);
+
+    /// @brief Recompute running sums and min/max queues from the content of the buffer, O(N)
+    void renormalise();
+
+    /// @brief Streaming insert of a block which does not cross the end of the ring
+    void insertSegment(const T* el, const uint32_t &count);
+
+    /// @brief Convert statistics to engineering units, see setScale()
+    void applyScale();
+
 public:
-    using RingBuffer<T>::RingBuffer; // inherit constructors
+    /// @brief Construct a new empty Statistic Buffer with window N
+    StatisticBuffer() : StatisticBuffer(N) {};
+
+    /**
+     * @brief Construct a new empty Statistic Buffer
+     *
+     * @param maxSize - length of the window, at most N for the fixed variant
+     * @param streaming - keep running sums for mean and standard deviation and min/max queues
+     */
+    StatisticBuffer(const uint32_t &maxSize, bool streaming = true);
+
+    /**
+     * @brief Construct a new full Statistic Buffer with given elements
+     */
+    StatisticBuffer(std::initializer_list<T> il);
+
+    void insertOne(const T el);
+
+    /**
+     * @brief Insert a block of elements, oldest first, same statistics as insertOne() for each
+     *
+     * The block is copied into the ring in at most two segments, the running
+     * sums are updated in one pass over each segment. A block of at least
+     * maxSize elements replaces the whole window and the streaming structures
+     * are rebuilt from it once.
+     *
+     * @param el - elements to insert
+     * @param count - number of elements
+     */
+    void insertMany(const T* el, size_t count);
+    void insertMany(std::span<const T> els) { insertMany(els.data(), els.size()); }
+
     void updateStatistics();
 
+    /**
+     * @brief Set percentiles computed by updateStatistics(), default p5 and p95
+     *
+     * @param lowPercent - 0..100
+     * @param highPercent - 0..100
+     */
+    void setPercentiles(const float &lowPercent, const float &highPercent);
+
+    /**
+     * @brief Publish statistics as scale * value + offset, e.g. counts to volts
+     *
+     * Standard deviation is scaled by |scale|, min/max and the percentiles
+     * are swapped for negative scale.
+     *
+     * @param scale - gain of the conversion
+     * @param offset - value of zero
+     */
+    void setScale(const float &scale, const float &offset = 0);
+
+    /**
+     * @brief Percentile of the current window, O(log N) in streaming mode
+     *
+     * @param percent - 0..100, 50 is the median
+     */
+    float getPercentile(const float &percent);
+
     const float & getMean();
     const float & getStdDev();
     const float & getMax();
     const float & getMin();
     const float & getMedian();
-    void getStatistics(T* min, 
-                       T* max, 
-                       T* mean, 
-                       T* stdDev, 
-                       T* median = nullptr);
+    void getStatistics(float* min, 
+                       float* max, 
+                       float* mean, 
+                       float* stdDev, 
+                       float* median = nullptr);
+
+    /**
+     * @brief Copy percentiles to given pointers, nullptr is skipped
+     *
+     * @param low - low percentile (p5 by default)
+     * @param median - p50
+     * @param high - high percentile (p95 by default)
+     */
+    void getPercentiles(float* low, float* median, float* high);
 };
 
 
-template <class T>
-void StatisticBuffer<T>::getStatistics(T* min, 
-                                       T* max, 
-                                       T* mean, 
-                                       T* stdDev, 
-                                       T* median)
+template <class T, uint32_t N, class Sum>
+StatisticBuffer<T, N, Sum>::StatisticBuffer(const uint32_t &maxSize, bool streaming) 
+    : RingBuffer<T, N>(maxSize), streaming(streaming), 
+      minQueue(streaming ? maxSize : 0), maxQueue(streaming ? maxSize : 0), order(streaming ? maxSize : 0)
+{
+}
+
+
+template <class T, uint32_t N, class Sum>
+StatisticBuffer<T, N, Sum>::StatisticBuffer(std::initializer_list<T> il) 
+    : RingBuffer<T, N>(il), minQueue(il.size()), maxQueue(il.size()), order(il.size())
+{
+    renormalise();
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::renormalise()
+{
+    shift = this->maxCursor > 0 ? this->buffer[0] : 0;
+    sum = 0;
+    sumSq = 0;
+    for(uint32_t i = 0; i < this->maxCursor; i++)
+    {
+        Sum dev = this->buffer[i] - shift;
+        sum += dev;
+        sumSq += dev * dev;
+    }
+    // current lap started at position 0
+    nextShift = shift;
+    nextSum = 0;
+    nextSumSq = 0;
+    for(uint32_t i = 0; i < this->currentPos && i < this->maxCursor; i++)
+    {
+        Sum dev = this->buffer[i] - nextShift;
+        nextSum += dev;
+        nextSumSq += dev * dev;
+    }
+
+    // oldest element first
+    minQueue.clear();
+    maxQueue.clear();
+    order.clear();
+
+    // empty ring, nothing to queue and no position to take modulo of
+    if(this->maxSize == 0)
+    {
+        return;
+    }
+    uint32_t oldest = this->maxCursor == this->maxSize ? this->currentPos % this->maxSize : 0;
+    for(uint32_t i = 0; i < this->maxCursor; i++)
+    {
+        pushExtremes((oldest + i) % this->maxSize);
+        order.insert(this->buffer.get(), i);
+    }
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::pushExtremes(const uint32_t &pos)
+{
+    const T el = this->buffer[pos];
+
+    // drop elements which can not become extremes while the new one is in the window
+    while(!minQueue.empty() && this->buffer[minQueue.back()] >= el)
+    {
+        minQueue.popBack();
+    }
+    minQueue.pushBack(pos);
+
+    while(!maxQueue.empty() && this->buffer[maxQueue.back()] <= el)
+    {
+        maxQueue.popBack();
+    }
+    maxQueue.pushBack(pos);
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::insertOne(const T el)
+{
+    if(!streaming)
+    {
+        RingBuffer<T, N>::insertOne(el);
+        return;
+    }
+
+    // ring wraps around, start new lap relative to the current mean
+    if(this->currentPos >= this->maxSize || this->currentPos == 0)
+    {
+        nextShift = this->maxCursor > 0 ? shift + sum / this->maxCursor : el;
+        nextSum = 0;
+        nextSumSq = 0;
+        if(this->maxCursor == 0)
+        {
+            shift = nextShift;
+        }
+    }
+
+    // remove evicted element
+    if(this->maxCursor == this->maxSize)
+    {
+        uint32_t evictedPos = this->currentPos >= this->maxSize ? 0 : this->currentPos;
+        Sum dev = this->buffer[evictedPos] - shift;
+        sum -= dev;
+        sumSq -= dev * dev;
+
+        // evicted element is the oldest, if it is still queued it is at the front
+        if(!minQueue.empty() && minQueue.front() == evictedPos)
+        {
+            minQueue.popFront();
+        }
+        if(!maxQueue.empty() && maxQueue.front() == evictedPos)
+        {
+            maxQueue.popFront();
+        }
+
+        order.remove(this->buffer.get(), evictedPos);
+    }
+
+    RingBuffer<T, N>::insertOne(el);
+    pushExtremes(this->currentPos - 1);
+    order.insert(this->buffer.get(), this->currentPos - 1);
+
+    Sum dev = el - shift;
+    sum += dev;
+    sumSq += dev * dev;
+
+    Sum nextDev = el - nextShift;
+    nextSum += nextDev;
+    nextSumSq += nextDev * nextDev;
+
+    // lap finished, sums of this lap cover the whole window - drop the drifted ones
+    if(this->currentPos == this->maxSize)
+    {
+        shift = nextShift;
+        sum = nextSum;
+        sumSq = nextSumSq;
+    }
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::insertMany(const T* el, size_t count)
+{
+    if(!streaming || count == 0 || this->maxSize == 0)
+    {
+        RingBuffer<T, N>::insertMany(el, count);
+        return;
+    }
+
+    // whole window is replaced, one rebuild instead of evicting every element
+    if(count >= this->maxSize)
+    {
+        RingBuffer<T, N>::insertMany(el, count);
+        renormalise();
+        return;
+    }
+
+    // up to the end of the ring and the rest from its start
+    const uint32_t first = std::min<size_t>(count, this->maxSize - this->currentPos % this->maxSize);
+    insertSegment(el, first);
+    if(count > first)
+    {
+        insertSegment(el + first, count - first);
+    }
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::insertSegment(const T* el, const uint32_t &count)
+{
+    // ring wraps around, start new lap relative to the current mean
+    if(this->currentPos >= this->maxSize || this->currentPos == 0)
+    {
+        nextShift = this->maxCursor > 0 ? shift + sum / this->maxCursor : el[0];
+        nextSum = 0;
+        nextSumSq = 0;
+        if(this->maxCursor == 0)
+        {
+            shift = nextShift;
+        }
+    }
+
+    const uint32_t begin = this->currentPos >= this->maxSize ? 0 : this->currentPos;
+    const uint32_t end = begin + count;
+
+    // remove evicted elements, oldest first, before they are overwritten
+    const uint32_t evictedEnd = std::min(end, this->maxCursor);
+    for(uint32_t pos = begin; pos < evictedEnd; pos++)
+    {
+        Sum dev = this->buffer[pos] - shift;
+        sum -= dev;
+        sumSq -= dev * dev;
+
+        if(!minQueue.empty() && minQueue.front() == pos)
+        {
+            minQueue.popFront();
+        }
+        if(!maxQueue.empty() && maxQueue.front() == pos)
+        {
+            maxQueue.popFront();
+        }
+
+        order.remove(this->buffer.get(), pos);
+    }
+
+    RingBuffer<T, N>::insertMany(el, count);
+
+    Sum segmentSum {0};
+    Sum segmentSumSq {0};
+    Sum nextSegmentSum {0};
+    Sum nextSegmentSumSq {0};
+    for(uint32_t pos = begin; pos < end; pos++)
+    {
+        pushExtremes(pos);
+        order.insert(this->buffer.get(), pos);
+
+        Sum dev = this->buffer[pos] - shift;
+        segmentSum += dev;
+        segmentSumSq += dev * dev;
+
+        Sum nextDev = this->buffer[pos] - nextShift;
+        nextSegmentSum += nextDev;
+        nextSegmentSumSq += nextDev * nextDev;
+    }
+    sum += segmentSum;
+    sumSq += segmentSumSq;
+    nextSum += nextSegmentSum;
+    nextSumSq += nextSegmentSumSq;
+
+    // lap finished, sums of this lap cover the whole window - drop the drifted ones
+    if(this->currentPos == this->maxSize)
+    {
+        shift = nextShift;
+        sum = nextSum;
+        sumSq = nextSumSq;
+    }
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::getStatistics(float* min, 
+                                            float* max, 
+                                            float* mean, 
+                                            float* stdDev, 
+                                            float* median)
 {
     if (min != nullptr) {
         *min = this->min;
@@ -63,95 +456,173 @@ void StatisticBuffer<T>::getStatistics(T* min,
 }
 
 
-template <class T>
-void StatisticBuffer<T>::updateStatistics()
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::updateStatistics()
 {
-    mean = 0;
-    min = INFINITY;
-    max = -INFINITY;
+    if(streaming)
+    {
+        min = minQueue.empty() ? INFINITY : this->buffer[minQueue.front()];
+        max = maxQueue.empty() ? -INFINITY : this->buffer[maxQueue.front()];
 
-    double sumOfElements {0};
-    double sumOfSquaredErrors {0};
-    std::vector<T> sortedBuffer(this->maxCursor);
+        momentsFromSums(shift, sum, sumSq, this->maxCursor, mean, stdDev);
 
-    for(int i=0; i<this->maxCursor; i++)
+        auto valueAt = [this](uint32_t rank) { return this->buffer[order.at(rank)]; };
+        median = interpolatePercentile(50, this->maxCursor, valueAt);
+        lowPercentile = interpolatePercentile(lowPercent, this->maxCursor, valueAt);
+        highPercentile = interpolatePercentile(highPercent, this->maxCursor, valueAt);
+    }
+    else
     {
-        T el = this->buffer[i];
-        sumOfElements += el;
+        min = INFINITY;
+        max = -INFINITY;
+
+        double sumOfElements {0};
+        double sumOfSquaredErrors {0};
 
-        if(el < min)
+        for(uint32_t i = 0; i < this->maxCursor; i++)
         {
-            min = el;
+            T el = this->buffer[i];
+            sumOfElements += el;
+
+            if(el < min)
+            {
+                min = el;
+            }
+
+            if(el > max)
+            {
+                max = el;
+            }
         }
 
-        if(el > max)
+        mean = sumOfElements / this->maxCursor;
+
+        for(uint32_t i = 0; i < this->maxCursor; i++)
         {
-            max = el;
+            sumOfSquaredErrors += powf(this->buffer[i] - mean, 2);
         }
 
-        sortedBuffer[i] = el;
+        stdDev = sqrtf(sumOfSquaredErrors / this->maxCursor);
+
+        std::vector<T> sortedBuffer(this->buffer.get(), this->buffer.get() + this->maxCursor);
+        std::sort(sortedBuffer.begin(), sortedBuffer.end());
+
+        auto valueAt = [&sortedBuffer](uint32_t rank) { return sortedBuffer[rank]; };
+        median = interpolatePercentile(50, this->maxCursor, valueAt);
+        lowPercentile = interpolatePercentile(lowPercent, this->maxCursor, valueAt);
+        highPercentile = interpolatePercentile(highPercent, this->maxCursor, valueAt);
     }
 
-    mean = sumOfElements / this->maxCursor;
+    applyScale();
 
-    for(int i=0; i<this->maxCursor; i++)
+    xlog_debug("Median: " << median);
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::applyScale()
+{
+    if(scale == 1 && offset == 0)
     {
-        sumOfSquaredErrors += powf(this->buffer[i] - mean, 2);
+        return;
     }
 
-    stdDev = sqrtf(sumOfSquaredErrors / this->maxCursor);
+    min = scale * min + offset;
+    max = scale * max + offset;
+    mean = scale * mean + offset;
+    stdDev = fabsf(scale) * stdDev;
+    median = scale * median + offset;
+    lowPercentile = scale * lowPercentile + offset;
+    highPercentile = scale * highPercentile + offset;
 
-    // Calculate the median
-    std::sort(sortedBuffer.begin(), sortedBuffer.end());
-    if (this->maxCursor % 2 == 0)
+    if(scale < 0)
     {
-        // If the number of elements is even, take the average of the middle two elements
-        median = (sortedBuffer[this->maxCursor / 2 - 1] + sortedBuffer[this->maxCursor / 2]) / 2.0;
+        std::swap(min, max);
+        std::swap(lowPercentile, highPercentile);
     }
-    else
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::setPercentiles(const float &lowPercent, const float &highPercent)
+{
+    this->lowPercent = lowPercent;
+    this->highPercent = highPercent;
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::setScale(const float &scale, const float &offset)
+{
+    this->scale = scale;
+    this->offset = offset;
+}
+
+
+template <class T, uint32_t N, class Sum>
+float StatisticBuffer<T, N, Sum>::getPercentile(const float &percent)
+{
+    float value;
+    if(streaming)
     {
-        // If the number of elements is odd, take the middle element
-        median = sortedBuffer[this->maxCursor / 2];
+        value = interpolatePercentile(percent, this->maxCursor, [this](uint32_t rank) { return this->buffer[order.at(rank)]; });
     }
-    
-    // print content of the sorted buffer
-    for (int i = 0; i < this->maxCursor; i++)
+    else
     {
-        xlog_trace("Sorted buffer[" << i << "]: " << sortedBuffer[i]);
+        std::vector<T> sortedBuffer(this->buffer.get(), this->buffer.get() + this->maxCursor);
+        std::sort(sortedBuffer.begin(), sortedBuffer.end());
+        value = interpolatePercentile(percent, this->maxCursor, [&sortedBuffer](uint32_t rank) { return sortedBuffer[rank]; });
+    }
+    return scale * value + offset;
+}
+
+
+template <class T, uint32_t N, class Sum>
+void StatisticBuffer<T, N, Sum>::getPercentiles(float* low, float* median, float* high)
+{
+    if (low != nullptr) {
+        *low = this->lowPercentile;
+    }
+
+    if (median != nullptr) {
+        *median = this->median;
+    }
+
+    if (high != nullptr) {
+        *high = this->highPercentile;
     }
-    xlog_debug("Median: " << median);
 }
 
 
-template <class T>
-const float & StatisticBuffer<T>::getStdDev()
+template <class T, uint32_t N, class Sum>
+const float & StatisticBuffer<T, N, Sum>::getStdDev()
 {
     return stdDev;
 }
 
 
-template <class T>
-const float & StatisticBuffer<T>::getMean()
+template <class T, uint32_t N, class Sum>
+const float & StatisticBuffer<T, N, Sum>::getMean()
 {
     return mean;
 }
 
 
-template <class T>
-const float & StatisticBuffer<T>::getMin()
+template <class T, uint32_t N, class Sum>
+const float & StatisticBuffer<T, N, Sum>::getMin()
 {
     return this->min;
 }
 
 
-template <class T>
-const float & StatisticBuffer<T>::getMax()
+template <class T, uint32_t N, class Sum>
+const float & StatisticBuffer<T, N, Sum>::getMax()
 {
     return max;
 }
 
-template <class T>
-const float & StatisticBuffer<T>::getMedian()
+template <class T, uint32_t N, class Sum>
+const float & StatisticBuffer<T, N, Sum>::getMedian()
 {
     return median;
 }
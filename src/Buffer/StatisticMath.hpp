@@ -0,0 +1,238 @@
+#ifndef STATISTIC_MATH_HPP
+#define STATISTIC_MATH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace Xerxes
+{
+
+
+/// @brief fraction bits of the fixed point mean computed from integer sums
+constexpr uint32_t FRACTION_BITS = 16;
+
+
+/// @brief Integer square root, floor(sqrt(x))
+inline uint64_t isqrt(uint64_t x)
+{
+    if(x == 0)
+    {
+        return 0;
+    }
+
+    // digit by digit, one result bit per iteration, from the highest even bit of x
+    uint64_t root = 0;
+    uint64_t bit = 1ull << ((63 - __builtin_clzll(x)) & ~1u);
+
+    while(bit != 0)
+    {
+        if(x >= root + bit)
+        {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+
+/**
+ * @brief Unsigned 128 bit integer as two halves
+ *
+ * The RP2040 is a 32 bit target without __int128, the products of the running
+ * sums are formed in two words so they can not overflow.
+ */
+struct Wide
+{
+    uint64_t hi;
+    uint64_t lo;
+};
+
+
+/// @brief Full product of two 64 bit integers
+inline Wide mulWide(const uint64_t a, const uint64_t b)
+{
+    const uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+    const uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+
+    const uint64_t ll = aLo * bLo;
+    const uint64_t lh = aLo * bHi;
+    const uint64_t hl = aHi * bLo;
+    const uint64_t hh = aHi * bHi;
+
+    // middle column with the carries from the lower one
+    const uint64_t mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & 0xffffffff)};
+}
+
+
+/// @brief a - b modulo 2^128, two's complement for signed results
+inline Wide subWide(const Wide &a, const Wide &b)
+{
+    return {a.hi - b.hi - (a.lo < b.lo), a.lo - b.lo};
+}
+
+
+/// @brief Magnitude of a signed 64 bit integer, INT64_MIN included
+inline uint64_t magnitude(const int64_t x)
+{
+    return x < 0 ? 0 - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+}
+
+
+/// @brief Full signed product of two 64 bit integers in two's complement
+inline Wide mulWideSigned(const int64_t a, const int64_t b)
+{
+    const Wide product = mulWide(magnitude(a), magnitude(b));
+    return (a < 0) != (b < 0) ? subWide({0, 0}, product) : product;
+}
+
+
+/// @brief Signed 128 bit two's complement to double
+inline double toDouble(const Wide &x)
+{
+    if(x.hi >> 63)
+    {
+        return -toDouble(subWide({0, 0}, x));
+    }
+    return std::ldexp(static_cast<double>(x.hi), 64) + static_cast<double>(x.lo);
+}
+
+
+/**
+ * @brief Mean and standard deviation from running sums relative to a reference value
+ *
+ * Integer sums are evaluated exactly - Q16 fixed point mean and an integer
+ * square root of n^2 * variance - and converted to float at the end.
+ *
+ * @param shift - reference value the sums are relative to
+ * @param sum - sum of (el - shift)
+ * @param sumSq - sum of (el - shift)^2
+ * @param count - number of summed elements, NaN for 0
+ */
+template <class Sum>
+void momentsFromSums(const Sum &shift, const Sum &sum, const Sum &sumSq, const uint32_t &count,
+                     float &mean, float &stdDev)
+{
+    if constexpr(std::is_integral_v<Sum>)
+    {
+        static_assert(std::is_signed_v<Sum> && sizeof(Sum) <= sizeof(int64_t), "integer sums are at most int64_t");
+
+        const Sum n = count;
+        if(n == 0)
+        {
+            mean = NAN;
+            stdDev = NAN;
+            return;
+        }
+
+        // Q16 mean, shift is an element so it converts exactly, the remainder
+        // is scaled separately so the sum itself never is
+        const Sum meanDevQ = sum / n * (Sum(1) << FRACTION_BITS) + sum % n * (Sum(1) << FRACTION_BITS) / n;
+        mean = static_cast<float>(shift) + static_cast<float>(meanDevQ) / (1u << FRACTION_BITS);
+
+        // n^2 * variance in 128 bits, exact and never negative
+        const Wide wide = subWide(mulWide(count, static_cast<uint64_t>(sumSq)), mulWideSigned(sum, sum));
+        if(wide.hi == 0 && wide.lo == 0)
+        {
+            stdDev = 0;
+            return;
+        }
+
+        // drop an even number of low bits so the rest fits into 64 bits
+        const uint32_t dropped = wide.hi == 0 ? 0 : (65 - __builtin_clzll(wide.hi)) & ~1u;
+        const uint64_t scaledVariance = dropped == 0 ? wide.lo
+                                        : dropped == 64 ? wide.hi
+                                        : (wide.hi << (64 - dropped)) | (wide.lo >> dropped);
+
+        // take the root with as many fraction bits as fit into 64 bits
+        const uint32_t fractionBits = __builtin_clzll(scaledVariance) / 2;
+        const uint64_t root = isqrt(scaledVariance << (2 * fractionBits));
+        stdDev = std::ldexp(static_cast<float>(root), static_cast<int>(dropped / 2 - fractionBits)) / n;
+    }
+    else
+    {
+        double meanDev = sum / count;
+        double variance = sumSq / count - meanDev * meanDev;
+        mean = shift + meanDev;
+        stdDev = sqrt(variance > 0 ? variance : 0);
+    }
+}
+
+
+/**
+ * @brief Population covariance from running sums relative to reference values
+ *
+ * Shifts cancel out, the sums of both channels only have to share the same
+ * samples. Integer sums give n^2 * covariance exactly, it is converted to
+ * float at the end.
+ *
+ * @param sumX - sum of (x - shiftX)
+ * @param sumY - sum of (y - shiftY)
+ * @param sumXY - sum of (x - shiftX) * (y - shiftY)
+ * @param count - number of summed pairs
+ * @return covariance, NaN for 0 pairs
+ */
+template <class Sum>
+float covarianceFromSums(const Sum &sumX, const Sum &sumY, const Sum &sumXY, const uint32_t &count)
+{
+    if(count == 0)
+    {
+        return NAN;
+    }
+
+    if constexpr(std::is_integral_v<Sum>)
+    {
+        static_assert(std::is_signed_v<Sum> && sizeof(Sum) <= sizeof(int64_t), "integer sums are at most int64_t");
+
+        // n^2 * covariance in 128 bits, exact
+        const Wide scaled = subWide(mulWideSigned(count, sumXY), mulWideSigned(sumX, sumY));
+        return toDouble(scaled) / (static_cast<double>(count) * count);
+    }
+    else
+    {
+        return sumXY / count - (sumX / count) * (sumY / count);
+    }
+}
+
+
+/**
+ * @brief Linear interpolation between the closest ranks, p50 is the median
+ *
+ * @param percent - 0..100
+ * @param count - number of elements, NaN for 0
+ * @param valueAt - element with given rank, 0 = smallest
+ */
+template <class ValueAt>
+float interpolatePercentile(const float &percent, const uint32_t &count, ValueAt valueAt)
+{
+    if(count == 0)
+    {
+        return NAN;
+    }
+
+    // fractional rank, even window and p50 gives the average of the middle two elements
+    double rank = std::clamp(percent, 0.0f, 100.0f) / 100.0 * (count - 1);
+    uint32_t lowRank = static_cast<uint32_t>(rank);
+    double fraction = rank - lowRank;
+
+    double low = valueAt(lowRank);
+    if(fraction == 0 || lowRank + 1 >= count)
+    {
+        return low;
+    }
+    double high = valueAt(lowRank + 1);
+    return low * (1 - fraction) + high * fraction;
+}
+
+
+} // namespace Xerxes
+
+#endif // !STATISTIC_MATH_HPP
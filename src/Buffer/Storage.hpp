@@ -0,0 +1,110 @@
+#ifndef STORAGE_HPP
+#define STORAGE_HPP
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Element storage of the buffers
+ *
+ * N > 0 is a std::array of N elements embedded in the owner, no heap is used.
+ * N = 0 is an array allocated on the heap with size given at runtime, freed
+ * in the destructor.
+ *
+ * Both variants are values: copies are deep, a move of the heap variant takes
+ * over the allocation and leaves the source empty.
+ *
+ * Owners size themselves with fit(): a fixed storage asked for more than N
+ * elements holds N, the owner is clamped to N too instead of writing past
+ * the array.
+ *
+ * @tparam E - type of the elements
+ * @tparam N - number of elements, 0 for size given at runtime
+ */
+template <class E, uint32_t N>
+class Storage
+{
+protected:
+    std::array<E, N> data {};
+
+public:
+    Storage() = default;
+
+    /// @brief Fixed storage holds N elements whatever the size, see fit()
+    explicit Storage(const uint32_t &size) { (void)size; }
+
+    /// @brief Number of elements the storage holds for the requested size, clamped to N
+    constexpr static uint32_t fit(const uint32_t &size) { return size < N ? size : N; }
+
+    E* get() { return data.data(); }
+    const E* get() const { return data.data(); }
+
+    E& operator[](const uint32_t &i) { return data[i]; }
+    const E& operator[](const uint32_t &i) const { return data[i]; }
+};
+
+
+template <class E>
+class Storage<E, 0>
+{
+protected:
+    std::unique_ptr<E[]> data;
+    uint32_t size {0};
+
+public:
+    Storage() = default;
+    explicit Storage(const uint32_t &size) : data(new E[size]{}), size(size) {}
+
+    /// @brief Number of elements the storage holds for the requested size
+    constexpr static uint32_t fit(const uint32_t &size) { return size; }
+
+    Storage(const Storage &other) : Storage(other.size)
+    {
+        std::copy(other.get(), other.get() + size, get());
+    }
+
+    Storage(Storage &&other) noexcept
+        : data(std::move(other.data)), size(std::exchange(other.size, 0))
+    {
+    }
+
+    Storage &operator=(const Storage &other)
+    {
+        if(this != &other)
+        {
+            // reuse allocation of the same size
+            if(size != other.size)
+            {
+                data.reset(new E[other.size]);
+                size = other.size;
+            }
+            std::copy(other.get(), other.get() + size, get());
+        }
+        return *this;
+    }
+
+    Storage &operator=(Storage &&other) noexcept
+    {
+        data = std::move(other.data);
+        size = std::exchange(other.size, 0);
+        return *this;
+    }
+
+    E* get() { return data.get(); }
+    const E* get() const { return data.get(); }
+
+    E& operator[](const uint32_t &i) { return data[i]; }
+    const E& operator[](const uint32_t &i) const { return data[i]; }
+};
+
+
+} // namespace Xerxes
+
+#endif // !STORAGE_HPP
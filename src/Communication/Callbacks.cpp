@@ -12,6 +12,10 @@
 #include "Core/Register.hpp"
 #include "Sensors/all.hpp"
 #include "Version.h"
+#include "RS485.hpp"
+
+#include <algorithm>
+#include <array>
 
 
 extern Xerxes::Slave xs;
@@ -91,6 +95,35 @@ void writeRegCallback(const Xerxes::Message &msg)
 }
 
 
+/**
+ * @brief Check if register range [offset, offset + len) overlaps [begin, end)
+ */
+static bool overlaps(const uint16_t offset, const uint16_t len, const uint16_t begin, const uint16_t end)
+{
+    return offset < end && offset + len > begin;
+}
+
+
+/**
+ * @brief Check if register range [offset, offset + len) holds lazily published statistics
+ *
+ * The analog values AV0..AV3 are included because a sensor may derive them in
+ * publishStatistics(), SCL3300a publishes the vibration amplitudes there. Reading
+ * them while the statistics are stale would return the amplitudes of an older window.
+ */
+static bool touchesStatistics(const uint16_t offset, const uint16_t len)
+{
+    return overlaps(offset, len, STATISTICS_BEGIN, STATISTICS_END) || 
+           overlaps(offset, len, AV0_OFFSET, SV0_OFFSET) ||
+           overlaps(offset, len, PERCENTILES_BEGIN, PERCENTILES_END) ||
+           overlaps(offset, len, SLOPES_BEGIN, SLOPES_END) ||
+           overlaps(offset, len, COVARIANCE_BEGIN, COVARIANCE_END) ||
+           overlaps(offset, len, WINDOW_1S_OFFSET, WINDOWS_END) ||
+           overlaps(offset, len, HISTOGRAM_OFFSET, HISTOGRAM_END) ||
+           overlaps(offset, len, ALLAN_OFFSET, ALLAN_END);
+}
+
+
 void readRegCallback(const Xerxes::Message &msg)
 {
     // read offset from message in little endian
@@ -103,13 +136,19 @@ void readRegCallback(const Xerxes::Message &msg)
     uint8_t len = msg.at(6);
 
     // check if offset and length are valid (not longer than register size)
-    if(offset + len > REGISTER_SIZE)
+    if(offset + len > EXTENDED_REGISTER_SIZE)
     {
         // send ACK_NOK
         xs.send(msg.srcAddr, MSGID_ACK_NOK);
         return;
     }
     
+    // lazy statistics are published when they are read after new samples arrived
+    if(touchesStatistics(offset, len))
+    {
+        device.refreshStatistics();
+    }
+
     std::vector<uint8_t> payload {};
 
     // read data from memory into payload vector
@@ -124,6 +163,82 @@ void readRegCallback(const Xerxes::Message &msg)
 }
 
 
+void readMultiCallback(const Xerxes::Message &msg)
+{
+    // src, dst and msgid precede the payload, the frame holds at most RS485::MAX_BODY bytes
+    constexpr size_t headerSize = 4;
+    constexpr size_t rangeSize = 3;
+    constexpr size_t maxReply = RS485::MAX_BODY - headerSize;
+
+    const size_t requestSize = msg.size() - headerSize;
+    if(requestSize == 0 || requestSize % rangeSize != 0)
+    {
+        xs.send(msg.srcAddr, MSGID_ACK_NOK);
+        return;
+    }
+
+    // validate all ranges first, the reply is all or nothing
+    size_t replySize = 0;
+    bool refresh = false;
+    for(size_t pos = headerSize; pos < msg.size(); pos += rangeSize)
+    {
+        const uint16_t offset = msg.at(pos) | (msg.at(pos + 1) << 8);
+        const uint8_t len = msg.at(pos + 2);
+        if(offset + len > EXTENDED_REGISTER_SIZE)
+        {
+            xs.send(msg.srcAddr, MSGID_ACK_NOK);
+            return;
+        }
+        replySize += len;
+        refresh |= touchesStatistics(offset, len);
+    }
+
+    if(replySize > maxReply)
+    {
+        xs.send(msg.srcAddr, MSGID_ACK_NOK);
+        return;
+    }
+
+    // gather the ranges straight from the register
+    std::array<uint8_t, maxReply> payload;
+    auto gather = [&]() {
+        auto out = payload.begin();
+        for(size_t pos = headerSize; pos < msg.size(); pos += rangeSize)
+        {
+            const uint16_t offset = msg.at(pos) | (msg.at(pos + 1) << 8);
+            const uint8_t len = msg.at(pos + 2);
+            out = std::copy_n(_reg.memTable + offset, len, out);
+        }
+    };
+
+    // statistics of all ranges from one cycle, core1 can not publish between the copies
+    if(refresh)
+    {
+        device.readStatistics(gather);
+    }
+    else
+    {
+        gather();
+    }
+
+    xs.send(msg.srcAddr, MSGID_READ_VALUE, std::span<const uint8_t>(payload.data(), replySize));
+}
+
+
+void pvSnapshotCallback(const Xerxes::Message &msg)
+{
+    PvSnapshot snapshot;
+    if(!device.snapshot(snapshot))
+    {
+        // no statistics to keep consistent with, the register is as good as it gets
+        _reg.readSnapshot(snapshot, time_us_64());
+    }
+
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&snapshot);
+    xs.send(msg.srcAddr, MSGID_PV_SNAPSHOT_VALUE, std::span<const uint8_t>(bytes, sizeof(snapshot)));
+}
+
+
 void sleepCallback(const Xerxes::Message &msg)
 {
     uint8_t raw_duration[4];
@@ -60,6 +60,37 @@ void writeRegCallback(const Xerxes::Message &msg);
 void readRegCallback(const Xerxes::Message &msg);
 
 
+/**
+ * @brief Read several register ranges callback
+ * 
+ * Read the ranges and reply with their bytes concatenated, in the order of the request.
+ * The request prototype is <MSGID_READ_MULTI> (<REG_ID> <LEN>)..., REG_ID is 2 bytes
+ * The reply prototype is <MSGID_READ_VALUE> <DATA>...
+ * 
+ * Replies MSGID_ACK_NOK if a range is outside of the register or if the reply
+ * would not fit into one message. Statistics in the ranges are all from one
+ * cycle, see Peripheral::readStatistics().
+ * 
+ * @param msg incoming message
+ * 
+ * @note All data are in little endian format - LSB first. 
+ */
+void readMultiCallback(const Xerxes::Message &msg);
+
+
+/**
+ * @brief Process value snapshot callback
+ * 
+ * Reply with timestamp, net cycle time, error register, pv0..3 and mean and stddev of pv0..3,
+ * all from the same cycle, see PvSnapshot for the layout.
+ * The request prototype is <MSGID_PV_SNAPSHOT>
+ * The reply prototype is <MSGID_PV_SNAPSHOT_VALUE> <PvSnapshot>
+ * 
+ * @param msg incoming message
+ */
+void pvSnapshotCallback(const Xerxes::Message &msg);
+
+
 /**
  * @brief Attempt to perform low power sleep
  * 
@@ -5,7 +5,7 @@ namespace Xerxes
 {
 
 
-RS485::RS485(queue_t *queueTx, queue_t *queueRx) : qtx(queueTx), qrx(queueRx)
+RS485::RS485(UartTxRing *txRing, UartRxRing *rxRing) : tx(txRing), rx(rxRing)
 {
 }
 
@@ -17,120 +17,90 @@ RS485::~RS485()
 
 bool RS485::sendData(const Packet & toSend) const
 {
-    // FIXME: this can check if queue has enough space before trying to send data
-    uint16_t sent {0};
-    for(const auto &el:toSend.getData())
-    {
-        // try to add byte to the queue, if it fails, break the loop
-        if(!queue_try_add(qtx, &el)) break;
-        sent++; // byte was sent successfully
-    }
-
-    
-    // return true if whole packet was sent
-    return sent == toSend.size();
+    // whole frame or nothing, a partial frame would only confuse the master
+    const auto &data = toSend.getData();
+    return tx->send(data.data(), data.size());
 }
 
 
 bool RS485::readData(const uint64_t timeoutUs, Packet &packet)
 {
-    // start timer
-    uint64_t start = time_us_64();
+    (void)timeoutUs;
 
-    // if RX queue is empty, immediately return
-    if(queue_is_empty(qrx))
+    if(!receivePacket())
     {
         return false;
     }
 
-    if(receivePacket(timeoutUs))
-    {
-        packet = Packet(incomingMessage);
-        return true;
-    }
-
-    return false;
+    packet = Packet(std::vector<uint8_t>(body.begin(), body.begin() + bodyLen));
+    return true;
 }
 
 
-bool RS485::receivePacket(const uint64_t timeoutUs)
+bool RS485::receivePacket()
 {
-    // check if the packet is in fifo buffer
-    uint8_t nextVal = 0;
-    
-    #ifdef NDEBUG
-    uint64_t tout = time_us_64() + timeoutUs;
-    #else
-    absolute_time_t tout;
-    tout._private_us_since_boot = time_us_64() + timeoutUs;
-    #endif // NDEBUG
-
-    uint8_t chks = Xerxes::SOH;
-
-    uint8_t msgLen = 0;
-    volatile bool waitForSoh = true;
-
-    // clear buffer
-    incomingMessage.clear();
-
-    while(!time_reached(tout))
+    uint8_t nextVal;
+    while(rx->tryGet(nextVal))
     {
-        if(waitForSoh)
+        chks += nextVal;
+
+        switch(state)
         {
-            if(queue_try_remove(qrx, &nextVal))
+        case ParserState::WAIT_SOH:
+            if(nextVal == Xerxes::SOH)
             {
-                if(nextVal == Xerxes::SOH)
-                {
-                    waitForSoh = false;
-                }
+                chks = Xerxes::SOH;
+                state = ParserState::LEN;
             }
-        }
-        else
-        {
-            // SOH was found, get msgLen
-            if(queue_try_remove(qrx, &msgLen))
+            break;
+
+        case ParserState::LEN:
+            // SOH, length and checksum are counted in, shorter is not a frame
+            if(nextVal < 3)
             {
-                // add msglen to checksum
-                chks += msgLen;
-                break; //break from this loop, continue to receive all data
+                state = ParserState::WAIT_SOH;
+                break;
             }
-        }
-    }
-
-    msgLen -= 3; // SOH and len was received, checksum is received at the end hence -3
-    while(!time_reached(tout) && msgLen)
-    {
-        if(queue_try_remove(qrx, &nextVal))
-        {
-            // something was received, slap it to the incoming vector
-            incomingMessage.emplace_back(nextVal);
-            chks += nextVal;
-            msgLen--;
-        }
-    }
+            bodyLen = nextVal - 3;
+            received = 0;
+            state = bodyLen ? ParserState::BODY : ParserState::CHECKSUM;
+            break;
+
+        case ParserState::BODY:
+            body[received++] = nextVal;
+            if(received == bodyLen)
+            {
+                state = ParserState::CHECKSUM;
+            }
+            break;
 
-    while(!time_reached(tout))
-    {
-        //wait for checksum byte
-        if(queue_try_remove(qrx, &nextVal))
-        {
-            chks += nextVal;
+        case ParserState::CHECKSUM:
+            state = ParserState::WAIT_SOH;
             if(chks == 0)
             {
                 // successfully received whole message
                 return true;
-            }   
-            else
-            {
-                return false;
             }
+            break;
         }
     }
 
+    // packet was cut off, do not wait for the rest of it
+    if(state != ParserState::WAIT_SOH && rx->idle())
+    {
+        state = ParserState::WAIT_SOH;
+    }
+
     return false;
 }
 
 
+RS485::ParserState RS485::parserState() const
+{
+    return state;
+}
+
+
 uint32_t remainingTime(const uint64_t & start, const uint64_t &timeout)
 {
     auto current_time = time_us_64();
@@ -3,10 +3,13 @@
 
 
 #include <Network.hpp>
-#include "pico/util/queue.h"
+#include "pico/time.h"
+#include "UartRxRing.hpp"
+#include "UartTxRing.hpp"
 #include <Packet.hpp>
 #include <Message.hpp>
 
+#include <array>
 #include <stdexcept>
 
 
@@ -28,33 +31,58 @@ uint32_t remainingTime(const uint64_t & start, const uint64_t &timeout);
  * @brief RS485 class for communication over RS485
  * 
  * This class is used to implement the RS485 communication. 
+ * 
+ * Incoming frames are parsed by a resumable state machine: each call takes
+ * the bytes waiting in the RX ring and returns, a frame which is not complete
+ * yet is continued by the next call.
  */
 class RS485 : public Network
 {
+public:
+    /// @brief Longest body of a frame, the length byte counts SOH, itself and the checksum too
+    constexpr static size_t MAX_BODY = UINT8_MAX - 3;
+
+    /// @brief State of the frame parser, named by the byte it waits for
+    enum class ParserState : uint8_t
+    {
+        WAIT_SOH,
+        LEN,
+        BODY,
+        CHECKSUM
+    };
+
 private:
-    /// @brief Pointer to the queue for sending data
-    queue_t *qtx;
-    /// @brief Pointer to the queue for receiving data
-    queue_t *qrx;
-    /// @brief Buffer for incoming data
-    std::vector<uint8_t> incomingMessage {};
+    /// @brief Pointer to the DMA ring for sending data
+    UartTxRing *tx;
+    /// @brief Pointer to the DMA ring with received data
+    UartRxRing *rx;
+
+    ParserState state {ParserState::WAIT_SOH};
+    /// @brief Body of the frame being parsed
+    std::array<uint8_t, MAX_BODY> body {};
+    uint8_t bodyLen {0};    ///< expected length of the body
+    uint8_t received {0};   ///< body bytes received so far
+    uint8_t chks {0};       ///< running checksum, 0 for a valid frame
 
 public:
     /**
      * @brief Construct a new RS485 object
      * 
-     * @param queueTx queue for sending data
-     * @param queueRx queue with received data
+     * @param txRing ring for sending data
+     * @param rxRing ring with received data
      */
-    RS485(queue_t *queueTx, queue_t *queueRx);
+    RS485(UartTxRing *txRing, UartRxRing *rxRing);
     ~RS485();
 
     /**
      * @brief send one Packet over the network
      * 
+     * The frame is copied into the TX ring and goes out by DMA, the call does
+     * not wait for the line.
+     * 
      * @param toSend packet to send
-     * @return true if the packet was sent successfully
-     * @return false if the packet was not sent successfully
+     * @return true if the packet was queued as a whole
+     * @return false if the packet did not fit into the TX ring
      */
     bool sendData(const Packet & toSend) const;
 
@@ -62,18 +90,29 @@ public:
     /**
      * @brief read one Packet from the network
      * 
-     * @param timeoutUs timeout in us
-     * @return Packet 
+     * Does not wait: parses the bytes received so far and returns, the
+     * timeout is kept for the Network interface only.
+     * 
+     * @param timeoutUs unused, the parser never waits for the line
+     * @param packet received packet, untouched if there is none
+     * @return true if a whole valid packet was received
      */
     bool readData(const uint64_t timeoutUs, Packet &packet);
     
     /**
-     * @brief check whether there is valid packet in the buffer
+     * @brief feed the bytes waiting in the RX ring to the frame parser
      * 
-     * @return true valid packet awaits in the incoming buffer
-     * @return false otherwise
+     * Stops after a complete frame, the bytes behind it stay in the ring for
+     * the next call. A frame is dropped if its checksum does not match or if
+     * the line goes idle in the middle of it, see UartRxRing::idle().
+     * 
+     * @return true valid frame awaits in the body buffer
+     * @return false otherwise, a partial frame is kept for the next call
      */
-    bool receivePacket(const uint64_t timeoutUs);
+    bool receivePacket();
+
+    /// @brief State of the frame parser
+    ParserState parserState() const;
 
 
     /**
@@ -0,0 +1,182 @@
+#include "UartRxRing.hpp"
+#include <algorithm>
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+
+namespace Xerxes
+{
+
+
+UartRxRing *UartRxRing::owners[NUM_DMA_CHANNELS] {};
+
+
+UartRxRing::UartRxRing(const uint32_t transferCount) : transferCount(transferCount)
+{
+}
+
+
+UartRxRing::~UartRxRing()
+{
+    stop();
+}
+
+
+void UartRxRing::start(uart_inst_t *uart, const uint baudrate)
+{
+    // DMA_IRQ_0 is shared with other DMA users, the handler is installed once
+    static bool irqInstalled = false;
+    if(!irqInstalled)
+    {
+        irq_add_shared_handler(DMA_IRQ_0, dmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        irqInstalled = true;
+    }
+
+    channel = dma_claim_unused_channel(true);
+    owners[channel] = this;
+
+    completed = 0;
+    readCount = 0;
+    seenCount = 0;
+    overrunFlag = false;
+    lastRxUs = time_us_64();
+
+    // 10 bits per character: start, 8 data and stop bit
+    idleUs = std::max<uint64_t>(UART_RX_IDLE_CHARS * 10 * 1'000'000ull / baudrate, UART_RX_IDLE_MIN_US);
+
+    // byte by byte from the data register of the UART to the ring, the write address wraps
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, UART_RX_RING_BITS);
+    channel_config_set_dreq(&config, uart_get_dreq(uart, false));
+
+    dma_channel_set_irq0_enabled(channel, true);
+    dma_channel_configure(channel, &config, ring, &uart_get_hw(uart)->dr, transferCount, true);
+}
+
+
+void UartRxRing::stop()
+{
+    if(channel < 0)
+    {
+        return;
+    }
+
+    dma_channel_set_irq0_enabled(channel, false);
+    dma_channel_abort(channel);
+    dma_channel_acknowledge_irq0(channel);
+    owners[channel] = nullptr;
+    dma_channel_unclaim(channel);
+    channel = -1;
+}
+
+
+void UartRxRing::dmaIrqHandler()
+{
+    for(uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+    {
+        UartRxRing *rx = owners[ch];
+        if(rx == nullptr || !dma_channel_get_irq0_status(ch))
+        {
+            continue;
+        }
+        dma_channel_acknowledge_irq0(ch);
+
+        // write address continues where the finished transfer stopped
+        rx->completed = rx->completed + rx->transferCount;
+        dma_channel_set_trans_count(ch, rx->transferCount, true);
+    }
+}
+
+
+uint32_t UartRxRing::received() const
+{
+    // completion IRQ must not restart the transfer between the two reads
+    const uint32_t status = save_and_disable_interrupts();
+    const uint32_t count = completed + (transferCount - dma_channel_hw_addr(channel)->transfer_count);
+    restore_interrupts(status);
+    return count;
+}
+
+
+uint32_t UartRxRing::poll()
+{
+    if(channel < 0)
+    {
+        return 0;
+    }
+
+    const uint32_t count = received();
+    if(count != seenCount)
+    {
+        seenCount = count;
+        lastRxUs = time_us_64();
+    }
+
+    // DMA lapped the reader, the unread bytes are overwritten
+    if(count - readCount > SIZE)
+    {
+        readCount = count;
+        overrunFlag = true;
+    }
+    return count - readCount;
+}
+
+
+uint32_t UartRxRing::available()
+{
+    return poll();
+}
+
+
+bool UartRxRing::tryGet(uint8_t &byte)
+{
+    // bytes seen by the last poll need no poll, only the lap check below
+    if(readCount == seenCount && poll() == 0)
+    {
+        return false;
+    }
+
+    byte = ring[readCount % SIZE];
+
+    // DMA may have lapped the reader since the last poll, the byte would be
+    // from a later lap; checked after the read so it can not change unseen
+    if(received() - readCount > SIZE)
+    {
+        // drops the unread bytes and flags the overrun
+        poll();
+        return false;
+    }
+
+    readCount++;
+    return true;
+}
+
+
+void UartRxRing::flush()
+{
+    poll();
+    readCount = seenCount;
+}
+
+
+bool UartRxRing::idle()
+{
+    poll();
+    return time_us_64() - lastRxUs >= idleUs;
+}
+
+
+bool UartRxRing::overrun()
+{
+    bool flag = overrunFlag;
+    overrunFlag = false;
+    return flag;
+}
+
+
+} // namespace Xerxes
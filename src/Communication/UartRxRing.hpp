@@ -0,0 +1,112 @@
+#ifndef __UART_RX_RING_HPP
+#define __UART_RX_RING_HPP
+
+
+#include <cstdint>
+#include "hardware/dma.h"
+#include "hardware/uart.h"
+#include "Core/Definitions.h"
+
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Receive ring of a UART filled by DMA
+ *
+ * A DMA channel paced by the RX DREQ of the UART copies every received byte
+ * into a ring of 2^UART_RX_RING_BITS bytes, the write address wraps in
+ * hardware, so the CPU does no work per byte. The consumer reads behind the
+ * DMA: the number of received bytes is the number of finished transfers plus
+ * what the running transfer moved (its transfer count counts down). A
+ * transfer is as long as possible, the completion IRQ only restarts it -
+ * bytes arriving meanwhile wait in the UART FIFO.
+ *
+ * If the DMA laps the consumer, the unread bytes are dropped and the overrun
+ * is reported by overrun().
+ *
+ * The line is idle when no byte arrived for UART_RX_IDLE_CHARS character
+ * times (at least UART_RX_IDLE_MIN_US), so a cut off frame can be dropped
+ * without waiting for the whole timeout. Idle time is measured between polls
+ * of the ring, there is no receive timeout interrupt - the FIFO is always
+ * drained by the DMA.
+ */
+class UartRxRing
+{
+public:
+    constexpr static uint32_t SIZE = 1u << UART_RX_RING_BITS;
+
+private:
+    /// @brief Ring written by the DMA, the ring wrap needs it aligned to its size
+    alignas(SIZE) volatile uint8_t ring[SIZE] {};
+
+    int channel {-1};
+    uint32_t transferCount;             ///< bytes per DMA transfer
+    volatile uint32_t completed {0};    ///< bytes of the finished transfers, counted by the IRQ
+
+    uint32_t readCount {0};     ///< bytes consumed since start()
+    uint32_t seenCount {0};     ///< bytes received at the last poll
+    uint64_t lastRxUs {0};      ///< time of the last poll which saw new bytes
+    uint32_t idleUs {0};
+    bool overrunFlag {false};
+
+    /// @brief Rings by DMA channel, for the shared DMA IRQ handler
+    static UartRxRing *owners[NUM_DMA_CHANNELS];
+
+    /// @brief Restart the finished transfers of the rings
+    static void dmaIrqHandler();
+
+    /// @brief Bytes received since start(), wraps at 2^32
+    uint32_t received() const;
+
+    /// @brief Update idle time and overrun, return bytes waiting in the ring
+    uint32_t poll();
+
+public:
+    /**
+     * @brief Construct a new UartRxRing object
+     *
+     * @param transferCount bytes per DMA transfer, restarted from the IRQ when finished
+     */
+    explicit UartRxRing(const uint32_t transferCount = UINT32_MAX);
+    ~UartRxRing();
+
+    /**
+     * @brief Claim a DMA channel and start receiving from the UART
+     *
+     * @param uart initialized UART, its RX IRQ must not be enabled
+     * @param baudrate baudrate of the UART, for the idle time
+     */
+    void start(uart_inst_t *uart, const uint baudrate);
+
+    /// @brief Stop the DMA and release the channel
+    void stop();
+
+    /// @brief Number of bytes waiting in the ring
+    uint32_t available();
+
+    /**
+     * @brief Take the oldest byte from the ring
+     *
+     * @param byte received byte
+     * @return true if there was a byte, false also if the DMA overwrote it,
+     *  see overrun()
+     */
+    bool tryGet(uint8_t &byte);
+
+    /// @brief Drop all received bytes
+    void flush();
+
+    /// @brief No byte arrived for the idle time, polls the ring
+    bool idle();
+
+    /// @brief Unread bytes were overwritten since the last call, clears the flag
+    bool overrun();
+};
+
+
+} // namespace Xerxes
+
+
+#endif // !__UART_RX_RING_HPP
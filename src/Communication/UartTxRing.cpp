@@ -0,0 +1,147 @@
+#include "UartTxRing.hpp"
+#include <algorithm>
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+
+namespace Xerxes
+{
+
+
+UartTxRing *UartTxRing::owners[NUM_DMA_CHANNELS] {};
+
+
+UartTxRing::~UartTxRing()
+{
+    stop();
+}
+
+
+void UartTxRing::start(uart_inst_t *uart)
+{
+    // DMA_IRQ_0 is shared with other DMA users, the handler is installed once
+    static bool irqInstalled = false;
+    if(!irqInstalled)
+    {
+        irq_add_shared_handler(DMA_IRQ_0, dmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        irqInstalled = true;
+    }
+
+    channel = dma_claim_unused_channel(true);
+    owners[channel] = this;
+
+    head = 0;
+    tail = 0;
+    inFlight = 0;
+    overflowFlag = false;
+
+    // byte by byte from the ring to the data register of the UART, the read address wraps
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_ring(&config, false, UART_TX_RING_BITS);
+    channel_config_set_dreq(&config, uart_get_dreq(uart, true));
+
+    dma_channel_set_irq0_enabled(channel, true);
+    dma_channel_configure(channel, &config, &uart_get_hw(uart)->dr, ring, 0, false);
+}
+
+
+void UartTxRing::stop()
+{
+    if(channel < 0)
+    {
+        return;
+    }
+
+    dma_channel_set_irq0_enabled(channel, false);
+    dma_channel_abort(channel);
+    dma_channel_acknowledge_irq0(channel);
+    owners[channel] = nullptr;
+    dma_channel_unclaim(channel);
+    channel = -1;
+}
+
+
+void UartTxRing::transmit()
+{
+    const uint32_t len = head - tail;
+    if(len == 0)
+    {
+        return;
+    }
+
+    // set before the trigger, the transfer may complete right away
+    inFlight = len;
+    dma_channel_set_read_addr(channel, ring + tail % SIZE, false);
+    dma_channel_set_trans_count(channel, len, true);
+}
+
+
+void UartTxRing::dmaIrqHandler()
+{
+    for(uint ch = 0; ch < NUM_DMA_CHANNELS; ch++)
+    {
+        UartTxRing *tx = owners[ch];
+        if(tx == nullptr || !dma_channel_get_irq0_status(ch))
+        {
+            continue;
+        }
+        dma_channel_acknowledge_irq0(ch);
+
+        tx->tail = tx->tail + tx->inFlight;
+        tx->inFlight = 0;
+        tx->transmit();
+    }
+}
+
+
+bool UartTxRing::send(const uint8_t *data, const size_t len)
+{
+    if(channel < 0)
+    {
+        return false;
+    }
+
+    // completion IRQ moves tail and starts transfers
+    const uint32_t status = save_and_disable_interrupts();
+    if(len > SIZE - (head - tail))
+    {
+        overflowFlag = true;
+        restore_interrupts(status);
+        return false;
+    }
+
+    // up to two copies, the frame may wrap around the end of the ring
+    const uint32_t pos = head % SIZE;
+    const size_t first = std::min<size_t>(len, SIZE - pos);
+    std::copy(data, data + first, ring + pos);
+    std::copy(data + first, data + len, ring);
+    head = head + len;
+
+    if(inFlight == 0)
+    {
+        transmit();
+    }
+    restore_interrupts(status);
+    return true;
+}
+
+
+bool UartTxRing::idle() const
+{
+    return head == tail;
+}
+
+
+bool UartTxRing::overflow()
+{
+    bool flag = overflowFlag;
+    overflowFlag = false;
+    return flag;
+}
+
+
+} // namespace Xerxes
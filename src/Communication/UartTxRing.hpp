@@ -0,0 +1,87 @@
+#ifndef __UART_TX_RING_HPP
+#define __UART_TX_RING_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include "hardware/dma.h"
+#include "hardware/uart.h"
+#include "Core/Definitions.h"
+
+
+namespace Xerxes
+{
+
+
+/**
+ * @brief Transmit ring of a UART read by DMA
+ *
+ * send() copies a frame into a ring of 2^UART_TX_RING_BITS bytes and returns
+ * right away. A DMA channel paced by the TX DREQ of the UART moves the bytes
+ * to the TX FIFO while the CPU keeps on working. The read address wraps in
+ * hardware, so all queued bytes go out in one transfer. The completion IRQ
+ * releases them and starts a transfer of the frames queued meanwhile.
+ *
+ * A frame which does not fit into the free space is rejected as a whole and
+ * reported by overflow().
+ */
+class UartTxRing
+{
+public:
+    constexpr static uint32_t SIZE = 1u << UART_TX_RING_BITS;
+
+private:
+    /// @brief Ring read by the DMA, the ring wrap needs it aligned to its size
+    alignas(SIZE) uint8_t ring[SIZE] {};
+
+    int channel {-1};
+
+    volatile uint32_t head {0};     ///< bytes queued since start()
+    volatile uint32_t tail {0};     ///< bytes sent since start(), moved by the IRQ
+    volatile uint32_t inFlight {0}; ///< bytes of the running transfer, 0 when idle
+    bool overflowFlag {false};
+
+    /// @brief Ring with a DMA channel, for the shared DMA IRQ handler
+    static UartTxRing *owners[NUM_DMA_CHANNELS];
+
+    /// @brief Release the sent bytes and send the ones queued meanwhile
+    static void dmaIrqHandler();
+
+    /// @brief Start a transfer of all queued bytes, with interrupts disabled and no transfer running
+    void transmit();
+
+public:
+    UartTxRing() = default;
+    ~UartTxRing();
+
+    /**
+     * @brief Claim a DMA channel for transmitting to the UART
+     *
+     * @param uart initialized UART
+     */
+    void start(uart_inst_t *uart);
+
+    /// @brief Stop the DMA and release the channel, queued bytes are dropped
+    void stop();
+
+    /**
+     * @brief Queue a frame, it goes out in the background
+     *
+     * @param data bytes of the frame
+     * @param len length of the frame
+     * @return true if the frame was queued, false if it does not fit
+     */
+    bool send(const uint8_t *data, const size_t len);
+
+    /// @brief All queued bytes were handed over to the UART
+    bool idle() const;
+
+    /// @brief A frame was rejected since the last call, clears the flag
+    bool overflow();
+};
+
+
+} // namespace Xerxes
+
+
+#endif // !__UART_TX_RING_HPP
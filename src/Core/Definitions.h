@@ -13,9 +13,36 @@
 #define MESSAGE_OFFSET              FLASH_PAGE_SIZE * 3   // 768 bytes
 #define REGISTER_SIZE               FLASH_PAGE_SIZE * 4   // 1024 bytes
 
-#define RX_TX_QUEUE_SIZE            256 ///< 256 bytes
+/** @brief registers beyond REGISTER_SIZE of the protocol, read only */
+#define EXTENDED_OFFSET             REGISTER_SIZE           // 1024 bytes
+#define EXTENDED_REGISTER_SIZE      FLASH_PAGE_SIZE * 8     // 2048 bytes
+
 #define FIFO_DEPTH                  32  ///< 32 bytes
 
+/** @brief Read several register ranges in one request, replied by MSGID_READ_VALUE. Not in MessageId.h of the protocol yet */
+#define MSGID_READ_MULTI            0x0203
+/** @brief Request the process values with their statistics as PvSnapshot, replied by MSGID_PV_SNAPSHOT_VALUE */
+#define MSGID_PV_SNAPSHOT           0x0204
+#define MSGID_PV_SNAPSHOT_VALUE     0x0205
+/** @brief Layout version of PvSnapshot, first field of the reply */
+#define PV_SNAPSHOT_VERSION         1
+
+// UART receive ring filled by DMA, 2^bits bytes, see UartRxRing
+#ifndef UART_RX_RING_BITS
+#define UART_RX_RING_BITS           10  ///< 1024 bytes
+#endif // !UART_RX_RING_BITS
+// UART transmit ring read by DMA, 2^bits bytes, see UartTxRing
+#ifndef UART_TX_RING_BITS
+#define UART_TX_RING_BITS           10  ///< 1024 bytes
+#endif // !UART_TX_RING_BITS
+// line is idle after this many character times without a byte, but not sooner than UART_RX_IDLE_MIN_US
+#ifndef UART_RX_IDLE_CHARS
+#define UART_RX_IDLE_CHARS          4
+#endif // !UART_RX_IDLE_CHARS
+#ifndef UART_RX_IDLE_MIN_US
+#define UART_RX_IDLE_MIN_US         1000    ///< USB-RS485 adapters of the master pause between 1 ms USB frames
+#endif // !UART_RX_IDLE_MIN_US
+
 /// @brief Use last sector of flash for storing data
 #define FLASH_TARGET_OFFSET         PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE
 
@@ -24,12 +51,122 @@
 #define RING_BUFFER_LEN     100
 #endif // !RING_BUFFER_LEN
 
+// RAM of the window statistics of a device in bytes, checked at compile time, see Sensor
+// 4 float channels take 20 bytes per sample, 132 bytes with min/max and percentiles
+#ifndef STATISTICS_RAM_BUDGET
+#define STATISTICS_RAM_BUDGET       (64 * 1024)
+#endif // !STATISTICS_RAM_BUDGET
+
+// outlier rejection, see MASK_CONFIG_REJECT_OUTLIERS: samples in the median window and distance in standard deviations
+#ifndef HAMPEL_WINDOW
+#define HAMPEL_WINDOW       7
+#endif // !HAMPEL_WINDOW
+#ifndef HAMPEL_THRESHOLD
+#define HAMPEL_THRESHOLD    3
+#endif // !HAMPEL_THRESHOLD
+
+
+/* memory map of values not covered by MemoryMap.h */
+
+// memory offset of the 5th percentile of the process values (read only)
+#define P5_PV0_OFFSET               READ_ONLY_OFFSET + 48   // 560
+#define P5_PV1_OFFSET               READ_ONLY_OFFSET + 52   // 564
+#define P5_PV2_OFFSET               READ_ONLY_OFFSET + 56   // 568
+#define P5_PV3_OFFSET               READ_ONLY_OFFSET + 60   // 572
+
+// memory offset of the median of the process values (read only)
+#define P50_PV0_OFFSET              READ_ONLY_OFFSET + 64   // 576
+#define P50_PV1_OFFSET              READ_ONLY_OFFSET + 68   // 580
+#define P50_PV2_OFFSET              READ_ONLY_OFFSET + 72   // 584
+#define P50_PV3_OFFSET              READ_ONLY_OFFSET + 76   // 588
+
+// memory offset of the 95th percentile of the process values (read only)
+#define P95_PV0_OFFSET              READ_ONLY_OFFSET + 80   // 592
+#define P95_PV1_OFFSET              READ_ONLY_OFFSET + 84   // 596
+#define P95_PV2_OFFSET              READ_ONLY_OFFSET + 88   // 600
+#define P95_PV3_OFFSET              READ_ONLY_OFFSET + 92   // 604
+
+// memory offset of the least-squares slope of the process values over the statistics window, per hour (read only)
+#define SLOPE_PV0_OFFSET            READ_ONLY_OFFSET + 96   // 608
+#define SLOPE_PV1_OFFSET            READ_ONLY_OFFSET + 100  // 612
+#define SLOPE_PV2_OFFSET            READ_ONLY_OFFSET + 104  // 616
+#define SLOPE_PV3_OFFSET            READ_ONLY_OFFSET + 108  // 620
+
+// memory offset of the number of samples of the process values replaced as outliers (uint32, read only)
+#define REJECTED_PV0_OFFSET         READ_ONLY_OFFSET + 112  // 624
+#define REJECTED_PV1_OFFSET         READ_ONLY_OFFSET + 116  // 628
+#define REJECTED_PV2_OFFSET         READ_ONLY_OFFSET + 120  // 632
+#define REJECTED_PV3_OFFSET         READ_ONLY_OFFSET + 124  // 636
+
+// memory offset of the covariance of the process values over the statistics window (read only)
+// upper triangle row by row: c00 c01 c02 c03 c11 c12 c13 c22 c23 c33, diagonal is the variance
+#define COVARIANCE_OFFSET           READ_ONLY_OFFSET + 128  // 640
+#define COVARIANCE_END              READ_ONLY_OFFSET + 168  // 680
+
+// memory offset of the statistics over the last 1 s, 10 s and 60 s (read only, extended)
+// each block holds mean, stddev, min and max of pv0..3, see StatisticsBlock
+#define WINDOW_1S_OFFSET            EXTENDED_OFFSET + 0     // 1024
+#define WINDOW_10S_OFFSET           EXTENDED_OFFSET + 64    // 1088
+#define WINDOW_60S_OFFSET           EXTENDED_OFFSET + 128   // 1152
+#define WINDOWS_END                 EXTENDED_OFFSET + 192   // 1216
+
+// memory offset of the histograms of pv0..3 (read only, extended), see HistogramBlock
+// 32 uint32 bins per pv (128 bytes each), then underflow and overflow counts of pv0..3
+#define HISTOGRAM_BINS              32
+#define HISTOGRAM_OFFSET            WINDOWS_END             // 1216
+#define HISTOGRAM_PV0_OFFSET        HISTOGRAM_OFFSET + 0    // 1216
+#define HISTOGRAM_PV1_OFFSET        HISTOGRAM_OFFSET + 128  // 1344
+#define HISTOGRAM_PV2_OFFSET        HISTOGRAM_OFFSET + 256  // 1472
+#define HISTOGRAM_PV3_OFFSET        HISTOGRAM_OFFSET + 384  // 1600
+#define HISTOGRAM_UNDERFLOW_OFFSET  HISTOGRAM_OFFSET + 512  // 1728
+#define HISTOGRAM_OVERFLOW_OFFSET   HISTOGRAM_OFFSET + 528  // 1744
+#define HISTOGRAM_END               HISTOGRAM_OFFSET + 544  // 1760
+
+// memory offset of the Allan deviation of pv0..3 (read only, extended), see AllanBlock
+// 13 floats per pv (52 bytes each) for tau = 1 s, 2 s, 4 s ... 4096 s
+#define ALLAN_TAUS                  13
+#define ALLAN_OFFSET                HISTOGRAM_END           // 1760
+#define ALLAN_PV0_OFFSET            ALLAN_OFFSET + 0        // 1760
+#define ALLAN_PV1_OFFSET            ALLAN_OFFSET + 52       // 1812
+#define ALLAN_PV2_OFFSET            ALLAN_OFFSET + 104      // 1864
+#define ALLAN_PV3_OFFSET            ALLAN_OFFSET + 156      // 1916
+#define ALLAN_END                   ALLAN_OFFSET + 208      // 1968
+
+// time constant of the exponentially weighted statistics in ms (uint32), see MASK_CONFIG_EW_STATS
+#define EW_TIME_CONSTANT_OFFSET     CONFIG_VAL0_OFFSET      // 48
+// length of the statistics window in ms (uint32), 0 for RING_BUFFER_LEN samples
+#define STATISTICS_WINDOW_OFFSET    CONFIG_VAL1_OFFSET      // 52
+// lower edge of the first histogram bin and width of a bin (float), see MASK_CONFIG_HISTOGRAMS, histogram is off for width <= 0
+#define HISTOGRAM_MIN_OFFSET        CONFIG_VAL2_OFFSET      // 56
+#define HISTOGRAM_WIDTH_OFFSET      CONFIG_VAL3_OFFSET      // 60
+
+// registers computed from the statistic buffers, see MASK_CONFIG_LAZY_STATS
+#define STATISTICS_BEGIN            MEAN_PV0_OFFSET         // 272, mean, stddev, min, max
+#define STATISTICS_END              DV0_OFFSET              // 336
+#define PERCENTILES_BEGIN           P5_PV0_OFFSET           // 560, p5, p50, p95
+#define PERCENTILES_END             P95_PV3_OFFSET + 4      // 608
+#define SLOPES_BEGIN                SLOPE_PV0_OFFSET        // 608
+#define SLOPES_END                  SLOPE_PV3_OFFSET + 4    // 624
+#define COVARIANCE_BEGIN            COVARIANCE_OFFSET       // 640
+
 
 /* config masks */
 /* If true use free run, if false: wait for sync packet */
 #define MASK_CONFIG_FREE_RUN        1<<0
 /* if true, enable automatic calculation of the statistics */
 #define MASK_CONFIG_CALC_STATS      1<<1
+/* if true, samples are only inserted, statistics are computed when read or in idle time of core1 */
+#define MASK_CONFIG_LAZY_STATS      (1<<2)
+/* if true, mean and stddev are exponentially weighted with time constant EW_TIME_CONSTANT_OFFSET instead of a sample window */
+#define MASK_CONFIG_EW_STATS        (1<<3)
+/* if true, outliers of the process values are replaced by the median of the last HAMPEL_WINDOW samples before the statistics */
+#define MASK_CONFIG_REJECT_OUTLIERS (1<<4)
+/* if true, the process values are folded into the 1 s, 10 s and 60 s windows */
+#define MASK_CONFIG_WINDOWS         (1<<5)
+/* if true, the process values are counted in the histograms, see HISTOGRAM_MIN_OFFSET */
+#define MASK_CONFIG_HISTOGRAMS      (1<<6)
+/* if true, the Allan deviation of the process values is computed */
+#define MASK_CONFIG_ALLAN           (1<<7)
 
 
 /* Default values */
@@ -0,0 +1,108 @@
+#ifndef __DISPATCH_TABLE_HPP
+#define __DISPATCH_TABLE_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <Message.hpp>
+#include <MessageId.h>
+#include <Network.hpp>
+
+
+namespace Xerxes
+{
+
+
+/// @brief Messages a handler is called for
+enum class Target : uint8_t
+{
+    UNICAST,    ///< only messages addressed to this device
+    BROADCAST   ///< messages addressed to this device or to all devices
+};
+
+
+/**
+ * @brief Handler of one message id with its address filter
+ *
+ * Plain function pointer, the handler does not live on the heap and is
+ * called without another layer of std::function.
+ */
+struct Route
+{
+    msgid_t msgId;
+    Target target;
+    void (*handler)(const Message &);
+
+    /**
+     * @brief Check whether the message is meant for the handler
+     *
+     * @param dstAddr destination address of the message
+     * @param address address of this device
+     */
+    constexpr bool accepts(const uint8_t dstAddr, const uint8_t address) const
+    {
+        if(dstAddr == BROADCAST_ADDR)
+        {
+            return target == Target::BROADCAST;
+        }
+        return dstAddr == address;
+    }
+};
+
+
+/**
+ * @brief Build a dispatch table sorted by message id at compile time
+ *
+ * A message id bound twice fails the constant evaluation, i.e. the build.
+ *
+ * @param routes handlers in any order
+ * @return std::array<Route, N> handlers sorted by message id, see dispatch()
+ */
+template <size_t N>
+consteval std::array<Route, N> makeDispatchTable(const Route (&routes)[N])
+{
+    std::array<Route, N> table {};
+    std::copy(routes, routes + N, table.begin());
+    std::sort(table.begin(), table.end(), [](const Route &a, const Route &b) { return a.msgId < b.msgId; });
+
+    for(size_t i = 1; i < N; i++)
+    {
+        if(table[i - 1].msgId == table[i].msgId)
+        {
+            throw "message id is bound twice";
+        }
+    }
+    return table;
+}
+
+
+/**
+ * @brief Call the handler of the message, if there is one and it accepts the address
+ *
+ * @param table handlers sorted by message id, see makeDispatchTable()
+ * @param msg received message
+ * @param address address of this device
+ * @return true if a handler was called
+ */
+inline bool dispatch(std::span<const Route> table, const Message &msg, const uint8_t address)
+{
+    // binary search, the table is sorted
+    auto it = std::lower_bound(table.begin(), table.end(), msg.msgId,
+                               [](const Route &route, const msgid_t id) { return route.msgId < id; });
+    if(it == table.end() || it->msgId != msg.msgId || !it->accepts(msg.dstAddr, address))
+    {
+        return false;
+    }
+
+    it->handler(msg);
+    return true;
+}
+
+
+} // namespace Xerxes
+
+
+#endif // !__DISPATCH_TABLE_HPP
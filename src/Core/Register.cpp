@@ -1,4 +1,5 @@
 #include "Core/Register.hpp"
+#include <algorithm>
 
 
 namespace Xerxes
@@ -33,6 +34,18 @@ bool Register::errorCheck(const uint64_t& errorBit)
 }
 
 
+void Register::readSnapshot(PvSnapshot &out, const uint64_t timestampUs) const
+{
+    out.version = PV_SNAPSHOT_VERSION;
+    out.netCycleTimeUs = *netCycleTimeUs;
+    out.timestampUs = timestampUs;
+    out.error = *error;
+    std::copy(pv0, pv0 + 4, out.pv);
+    std::copy(meanPv0, meanPv0 + 4, out.mean);
+    std::copy(stdDevPv0, stdDevPv0 + 4, out.stdDev);
+}
+
+
 
 
 } // namespace Xerxes
\ No newline at end of file
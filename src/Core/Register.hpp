@@ -98,6 +98,57 @@ bool bitCheck(T& reg, const uint8_t n)
 }
     
 
+/**
+ * @brief Statistics of pv0..3 over one window, layout of the window register blocks
+ */
+struct StatisticsBlock
+{
+    float mean[4];
+    float stdDev[4];
+    float min[4];
+    float max[4];
+};
+
+
+/**
+ * @brief Histograms of pv0..3, layout of the histogram register block
+ */
+struct HistogramBlock
+{
+    uint32_t bins[4][HISTOGRAM_BINS];
+    uint32_t underflow[4];
+    uint32_t overflow[4];
+};
+
+
+/**
+ * @brief Allan deviation of pv0..3 for tau = 1 s, 2 s ... 2^(ALLAN_TAUS - 1) s, layout of the Allan register block
+ */
+struct AllanBlock
+{
+    float deviation[4][ALLAN_TAUS];
+};
+
+
+/**
+ * @brief Process values with their statistics from one cycle, payload of MSGID_PV_SNAPSHOT_VALUE
+ *
+ * Little endian and naturally aligned, without padding, so the master decodes
+ * it with struct.unpack("<IIQQ12f", payload). Later versions only append fields.
+ */
+struct PvSnapshot
+{
+    uint32_t version;           ///< PV_SNAPSHOT_VERSION
+    uint32_t netCycleTimeUs;
+    uint64_t timestampUs;       ///< time the process values were sampled
+    uint64_t error;
+    float pv[4];
+    float mean[4];
+    float stdDev[4];
+};
+static_assert(sizeof(PvSnapshot) == 72, "PvSnapshot must not have padding");
+
+
 /**
  * @brief Register class for storing all data in memory mapped registers
  * 
@@ -117,7 +168,7 @@ public:
     Register(/* args */);
     ~Register();
 
-    uint8_t memTable[REGISTER_SIZE];
+    uint8_t memTable[EXTENDED_REGISTER_SIZE];
 
     float* gainPv0       = (float *)(memTable + GAIN_PV0_OFFSET);
     float* gainPv1       = (float *)(memTable + GAIN_PV1_OFFSET);
@@ -140,6 +191,11 @@ public:
     uint32_t *config_val2            = (uint32_t *)(memTable + CONFIG_VAL2_OFFSET);  ///< Config bits of the device (1 byte)
     uint32_t *config_val3            = (uint32_t *)(memTable + CONFIG_VAL3_OFFSET);  ///< Config bits of the device (1 byte)
 
+    uint32_t *ewTimeConstantMs       = (uint32_t *)(memTable + EW_TIME_CONSTANT_OFFSET);  ///< Time constant of exponentially weighted statistics in ms, shares config_val0
+    uint32_t *statisticsWindowMs     = (uint32_t *)(memTable + STATISTICS_WINDOW_OFFSET);  ///< Length of the statistics window in ms, 0 for RING_BUFFER_LEN samples, shares config_val1
+    float *histogramMin              = (float *)(memTable + HISTOGRAM_MIN_OFFSET);  ///< Lower edge of the first histogram bin, shares config_val2
+    float *histogramWidth            = (float *)(memTable + HISTOGRAM_WIDTH_OFFSET);  ///< Width of a histogram bin, 0 disables the histograms, shares config_val3
+
     /* ### VOLATILE - PROCESS VALUES ### */
     float* pv0           = (float *)(memTable + PV0_OFFSET);    ///< Pointer to process value 0
     float* pv1           = (float *)(memTable + PV1_OFFSET);    ///< Pointer to process value 1
@@ -189,6 +245,40 @@ public:
     uint64_t* status     = (uint64_t *)(memTable + STATUS_OFFSET);  ///< Status register, holds status codes
     uint64_t* uid        = (uint64_t *)(memTable + UID_OFFSET);     ///< Unique ID of the device
 
+    float* p5Pv0         = (float *)(memTable + P5_PV0_OFFSET);     ///< 5th percentile of process value 0
+    float* p5Pv1         = (float *)(memTable + P5_PV1_OFFSET);     ///< 5th percentile of process value 1
+    float* p5Pv2         = (float *)(memTable + P5_PV2_OFFSET);     ///< 5th percentile of process value 2
+    float* p5Pv3         = (float *)(memTable + P5_PV3_OFFSET);     ///< 5th percentile of process value 3
+
+    float* p50Pv0        = (float *)(memTable + P50_PV0_OFFSET);    ///< Median of process value 0
+    float* p50Pv1        = (float *)(memTable + P50_PV1_OFFSET);    ///< Median of process value 1
+    float* p50Pv2        = (float *)(memTable + P50_PV2_OFFSET);    ///< Median of process value 2
+    float* p50Pv3        = (float *)(memTable + P50_PV3_OFFSET);    ///< Median of process value 3
+
+    float* p95Pv0        = (float *)(memTable + P95_PV0_OFFSET);    ///< 95th percentile of process value 0
+    float* p95Pv1        = (float *)(memTable + P95_PV1_OFFSET);    ///< 95th percentile of process value 1
+    float* p95Pv2        = (float *)(memTable + P95_PV2_OFFSET);    ///< 95th percentile of process value 2
+    float* p95Pv3        = (float *)(memTable + P95_PV3_OFFSET);    ///< 95th percentile of process value 3
+
+    float* slopePv0      = (float *)(memTable + SLOPE_PV0_OFFSET);  ///< Trend of process value 0 over the statistics window, per hour
+    float* slopePv1      = (float *)(memTable + SLOPE_PV1_OFFSET);  ///< Trend of process value 1 over the statistics window, per hour
+    float* slopePv2      = (float *)(memTable + SLOPE_PV2_OFFSET);  ///< Trend of process value 2 over the statistics window, per hour
+    float* slopePv3      = (float *)(memTable + SLOPE_PV3_OFFSET);  ///< Trend of process value 3 over the statistics window, per hour
+
+    uint32_t* rejectedPv0 = (uint32_t *)(memTable + REJECTED_PV0_OFFSET);   ///< Samples of process value 0 replaced as outliers
+    uint32_t* rejectedPv1 = (uint32_t *)(memTable + REJECTED_PV1_OFFSET);   ///< Samples of process value 1 replaced as outliers
+    uint32_t* rejectedPv2 = (uint32_t *)(memTable + REJECTED_PV2_OFFSET);   ///< Samples of process value 2 replaced as outliers
+    uint32_t* rejectedPv3 = (uint32_t *)(memTable + REJECTED_PV3_OFFSET);   ///< Samples of process value 3 replaced as outliers
+
+    float* covariance    = (float *)(memTable + COVARIANCE_OFFSET); ///< Upper triangle of the covariance of pv0..3 over the statistics window, row by row
+
+    /* ### EXTENDED READ ONLY VALUES ### */
+    StatisticsBlock* window1s   = (StatisticsBlock *)(memTable + WINDOW_1S_OFFSET);    ///< Statistics of the last completed second
+    StatisticsBlock* window10s  = (StatisticsBlock *)(memTable + WINDOW_10S_OFFSET);   ///< Statistics of the last 10 completed seconds
+    StatisticsBlock* window60s  = (StatisticsBlock *)(memTable + WINDOW_60S_OFFSET);   ///< Statistics of the last 6 completed 10 s blocks
+    HistogramBlock*  histogram  = (HistogramBlock *)(memTable + HISTOGRAM_OFFSET);     ///< Histograms of pv0..3 since the range was set
+    AllanBlock*      allan      = (AllanBlock *)(memTable + ALLAN_OFFSET);             ///< Allan deviation of pv0..3 since the statistics were started
+
     /* ### MESSAGE STRING MEMORY ### */
     char* message    = (char *)(memTable + MESSAGE_OFFSET); ///< Message string, holds messages (debug, info, warning, error)
 
@@ -206,6 +296,17 @@ public:
     /// @return true if the error bit is set
     /// @return false if the error bit is not set
     bool errorCheck(const uint64_t& errorBit);
+
+    /**
+     * @brief Fill the snapshot from the register as it is now
+     *
+     * Nothing keeps the values from changing meanwhile, see Sensor::snapshot()
+     * for a consistent one.
+     *
+     * @param out snapshot to fill
+     * @param timestampUs time the process values were sampled
+     */
+    void readSnapshot(PvSnapshot &out, const uint64_t timestampUs) const;
 };
 
 
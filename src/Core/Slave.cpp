@@ -10,7 +10,7 @@ Slave::Slave()
 }
 
 
-Slave::Slave(Protocol *protocol, const uint8_t address) : xp(protocol), address(address)
+Slave::Slave(Protocol *protocol, const uint8_t *address) : xp(protocol), address(address)
 {
 }
 
@@ -20,31 +20,37 @@ Slave::~Slave()
 }
 
 
-void Slave::bind(const msgid_t msgId, std::function<void(const Message&)> _f)
+void Slave::route(std::span<const Route> table)
 {
-    bindings.emplace(msgId, _f);
+    routes = table;
 }
 
 
-void Slave::call(const Message &msg) 
+bool Slave::call(const Message &msg) 
 {
-    if(bindings.contains(msg.msgId)){
-        // call a function bound to messageId
-        bindings[msg.msgId](msg);
-    }
+    // call a function routed to messageId
+    return dispatch(routes, msg, *address);
 }
 
 
 bool Slave::send(const uint8_t destinationAddress, const msgid_t msgId)
 {
-    Message message(address, destinationAddress, msgId);
+    Message message(*address, destinationAddress, msgId);
     return xp->sendMessage(message);
 }
 
 
 bool Slave::send(const uint8_t destinationAddress, const msgid_t msgId, const std::vector<uint8_t> &payload)
 {
-    Message message(address, destinationAddress, msgId, payload);
+    Message message(*address, destinationAddress, msgId, payload);
+    return xp->sendMessage(message);
+}
+
+
+bool Slave::send(const uint8_t destinationAddress, const msgid_t msgId, std::span<const uint8_t> payload)
+{
+    // Message of the protocol keeps its bytes in a vector, this is the only copy
+    Message message(*address, destinationAddress, msgId, std::vector<uint8_t>(payload.begin(), payload.end()));
     return xp->sendMessage(message);
 }
 
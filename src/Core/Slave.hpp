@@ -2,9 +2,9 @@
 #define __SLAVE_HPP
 
 #include <Protocol.hpp>
-#include <unordered_map>
-#include <functional>
+#include <span>
 #include <MessageId.h>
+#include "DispatchTable.hpp"
 
 namespace Xerxes
 {
@@ -13,16 +13,17 @@ namespace Xerxes
 /**
  * @brief Slave class
  * 
- * It is used to bind the functions to the message ids and to call the
+ * It is used to route the message ids to the functions and to call the
  * functions when a message with the corresponding message id is received.
+ * The routes are a table built at compile time, see makeDispatchTable().
  * 
  */
 class Slave
 {
 private:
-    Protocol *xp;
-    std::unordered_map<msgid_t, std::function<void(const Message&)>> bindings;
-    uint8_t address;
+    Protocol *xp {nullptr};
+    std::span<const Route> routes {};
+    const uint8_t *address {nullptr};
 
 public:
     /**
@@ -35,9 +36,9 @@ public:
      * @brief Construct a new Slave object
      * 
      * @param protocol pointer to the communication protocol
-     * @param address address of the slave
+     * @param address register with the address of the slave, read on every message
      */
-    Slave(Protocol *protocol, const uint8_t address);
+    Slave(Protocol *protocol, const uint8_t *address);
 
     /**
      * @brief Destroy the Slave object
@@ -46,22 +47,20 @@ public:
     ~Slave();
 
     /**
-     * @brief Bind a function to a message id
+     * @brief Route the message ids to the functions
      * 
-     * The function is called when a message with the corresponding message id is received.
-     * 
-     * @param msgId message id to bind the function to
-     * @param _f function to bind to the message id. It is called when a message with the
-     *  corresponding message id is received.
+     * @param table handlers sorted by message id, see makeDispatchTable(). It must
+     *  outlive the slave, it is not copied.
      */
-    void bind(const msgid_t msgId, std::function<void(const Message&)> _f);
+    void route(std::span<const Route> table);
 
     /**
-     * @brief Call the function bound to the message id
+     * @brief Call the function routed to the message id, if the message is meant for it
      * 
      * @param msg message to call the function with
+     * @return true if a function was called
      */
-    void call(const Message &msg);
+    bool call(const Message &msg);
 
     /**
      * @brief Send a message
@@ -84,12 +83,23 @@ public:
      */
     bool send(const uint8_t destinationAddress, const msgid_t msgId, const std::vector<uint8_t> &payload);
 
+    /**
+     * @brief Send a message with the payload in any contiguous memory
+     * 
+     * @param destinationAddress address of the destination
+     * @param msgId message id of the message
+     * @param payload payload of the message, e.g. a fixed buffer on the stack
+     * @return true if the message was sent successfully
+     * @return false if the message was not sent successfully
+     */
+    bool send(const uint8_t destinationAddress, const msgid_t msgId, std::span<const uint8_t> payload);
+
     /**
      * @brief Synchronize the slave with the master 
      * 
      * The slave is synchronized when it receives a valid message from the master. 
      * 
-     * @param timeoutUs timeout in microseconds
+     * @param timeoutUs timeout in microseconds, passed to the network, RS485 ignores it
      * @return true if the slave is synchronized
      * @return false if the slave is not synchronized
      */
@@ -15,45 +15,19 @@
 #include "hardware/irq.h"
 #include "hardware/flash.h"
 #include "hardware/rtc.h"
-#include "pico/util/queue.h"
+#include "Communication/UartRxRing.hpp"
+#include "Communication/UartTxRing.hpp"
 
 
 extern Xerxes::Register _reg;
-extern queue_t txFifo, rxFifo;
-
-
-void userInitQueue()
-{
-    queue_init(&txFifo, 1, RX_TX_QUEUE_SIZE);
-    queue_init(&rxFifo, 1, RX_TX_QUEUE_SIZE);
-}
-
-
-void uart_interrupt_handler()
-{
-    gpio_put(USR_LED_PIN, 1);
-
-    if(uart_is_readable(uart0))
-    {
-        unsigned char rcvd = uart_getc(uart0);
-        auto success = queue_try_add(&rxFifo, &rcvd);
-
-        if(!success)
-        {
-            // set cpu overload flag
-            *_reg.error |= ERROR_MASK_CPU_OVERLOAD;
-        }
-    }
-
-    gpio_put(USR_LED_PIN, 0);
-    irq_clear(UART0_IRQ);
-}
+extern Xerxes::UartTxRing txRing;
+extern Xerxes::UartRxRing rxRing;
 
 
 void userInitUart()
 {
     // Initialise UART 0 on 115200baud
-    uart_init(uart0, DEFAULT_BAUDRATE);
+    uint baudrate = uart_init(uart0, DEFAULT_BAUDRATE);
  
     // Set the GPIO pin mux to the UART - 16 is TX, 17 is RX
     gpio_set_function(RS_TX_PIN, GPIO_FUNC_UART);
@@ -70,13 +44,10 @@ void userInitUart()
     // disable stdio uart
     // stdio_set_driver_enabled(&stdio_uart, false);
 
-    // set uart interrupt handler, must be done before enabling uart interrupt
-    irq_set_exclusive_handler(UART0_IRQ, uart_interrupt_handler);
-    // enable uart interrupt
-    irq_set_enabled(UART0_IRQ, true);
-
-    // enable uart interrupt for receiving and transmitting
-    uart_set_irq_enables(uart0, true, false);
+    // no uart interrupt, bytes are moved between the rings and the FIFOs by DMA
+    uart_set_irq_enables(uart0, false, false);
+    rxRing.start(uart0, baudrate);
+    txRing.start(uart0);
 }
 
 
@@ -101,7 +72,7 @@ void userInitGpio()
 void userLoadDefaultValues()
 {
     // set default values for the registers
-    for(uint i=0; i<REGISTER_SIZE; i++)
+    for(uint i=0; i<EXTENDED_REGISTER_SIZE; i++)
     {
         _reg.memTable[i] = 0;
     }
@@ -128,9 +99,6 @@ void userInit()
     // initialize the gpios
     userInitGpio();
 
-    // initialize the queues for uart communication
-    userInitQueue();
-
     // initialize the flash memory and load the default values
     if(!userInitFlash((uint8_t *)_reg.memTable))
     {
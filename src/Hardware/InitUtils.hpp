@@ -4,24 +4,10 @@
 #include <stdint.h>
 
 
-/**
- * @brief Initialize the queues for the UART
- */
-void userInitQueue();
-
-
-/**
- * @brief Interrupt handler for the UART
- * 
- * This function is called when the UART receives a byte. The byte is received and then pushed to txFifo
- */
-void uart_interrupt_handler();
-
-
 /**
  * @brief Initialize the UART
  * 
- * This function initializes the UART and sets the interrupt handler `uart_interrupt_handler`. A RS485 transceiver is also initialized
+ * This function initializes the UART and starts the DMA rings `rxRing` and `txRing`, bytes are received and transmitted without an interrupt per byte. A RS485 transceiver is also initialized
  */
 void userInitUart(void);
 
@@ -51,7 +37,7 @@ void userLoadDefaultValues();
 /**
  * @brief Initialize the micro-controller using the Pico SDK.
  * 
- * This function initializes the clocks, GPIO pins, UART, flash memory and queues, if necessary it also loads the default values
+ * This function initializes the clocks, GPIO pins, UART and flash memory, if necessary it also loads the default values
  * 
  */
 void userInit();
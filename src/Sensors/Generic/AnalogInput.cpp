@@ -33,6 +33,12 @@ void AnalogInput::init(uint8_t numChannels, uint8_t oversampleBits)
     this->effectiveBitDepth = rpBitDepth + oversampleBits;
     this->numCounts = 1 << effectiveBitDepth;
 
+    // statistics of the used channels only
+    setChannelMask((1 << numChannels) - 1);
+
+    // statistics are kept in ADC counts and published on the same scale as the process values
+    setCountsPerUnit(numCounts);
+
     // init ADC
     adc_init();
     
@@ -114,42 +120,8 @@ void AnalogInput::update()
     }
 
 
-    // if calcStat is true, update statistics
-    if(_reg->config->bits.calcStat)
-    {
-        // insert new values into ring buffer
-        rbpv0.insertOne(*_reg->pv0);
-
-        // update statistics
-        rbpv0.updateStatistics();
-
-        // update min, max stddev etc...
-        rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
-    }
-
-    // if calcStat is true and numChannels > 1, update statistics for pv1
-    if(_reg->config->bits.calcStat && numChannels > 1)
-    {
-        rbpv1.insertOne(*_reg->pv1);
-        rbpv1.updateStatistics();
-        rbpv1.getStatistics(_reg->minPv1, _reg->maxPv1, _reg->meanPv1, _reg->stdDevPv1);
-    }
-
-    // if calcStat is true and numChannels > 2, update statistics for pv2
-    if(_reg->config->bits.calcStat && numChannels > 2)
-    {
-        rbpv2.insertOne(*_reg->pv2);
-        rbpv2.updateStatistics();
-        rbpv2.getStatistics(_reg->minPv2, _reg->maxPv2, _reg->meanPv2, _reg->stdDevPv2);
-    }
-
-    // if calcStat is true and numChannels > 3, update statistics for pv3
-    if(_reg->config->bits.calcStat && numChannels > 3)
-    {
-        rbpv3.insertOne(*_reg->pv3);
-        rbpv3.updateStatistics();
-        rbpv3.getStatistics(_reg->minPv3, _reg->maxPv3, _reg->meanPv3, _reg->stdDevPv3);
-    }
+    // if calcStat is true, insert counts into the statistics
+    insertSamples();
 }
 
 
@@ -24,7 +24,7 @@ constexpr uint8_t rpBitDepth                = 12;
  * @note AnalogInput uses oversampling to increase resolution, increasing SNR by 6dB per bit
  * @note n-bit oversampling increases sampling time too: sample time = 4^n * conversion time 
  */
-class AnalogInput : public Sensor
+class AnalogInput : public Sensor<CountStatistics<4, ORDER_ALL>>
 {
 private:
     uint64_t results[4] = {0, 0, 0, 0};  // up to 4 channels, 64 bit to avoid overflow
@@ -7,6 +7,7 @@
 #include "hardware/i2c.h"
 #include "pico/binary_info.h"
 #include <bitset>
+#include "Utils/Log.h"
 
 namespace Xerxes
 {
@@ -262,11 +263,8 @@ void DiscreteAnalog::init()
     // set update rate
     *_reg->desiredCycleTimeUs = _updateRateUs;
 
-    // initialize ringbuffer with size of RING_BUFFER_LEN (defined in Definitions.h)
-    rbpv0 = StatisticBuffer<float>(_updateRateHz);
-    rbpv1 = StatisticBuffer<float>(_updateRateHz);
-    rbpv2 = StatisticBuffer<float>(_updateRateHz);
-    rbpv3 = StatisticBuffer<float>(_updateRateHz);
+    // ratios are not ADC counts, the window keeps them in fixed point
+    setCountsPerUnit(_countsPerUnit);
 }
 
 void DiscreteAnalog::update() {
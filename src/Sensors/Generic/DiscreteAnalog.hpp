@@ -126,6 +126,7 @@ protected:
     typedef AnalogInput super;
     constexpr static uint32_t _updateRateHz = 50;  // update frequency in Hz
     constexpr static uint32_t _updateRateUs = _usInS / _updateRateHz;  // update rate in microseconds
+    constexpr static float _countsPerUnit = 1 << 20;  // fixed point ratios in the window, finer than the 16 bit ADC
 
 public:
     using AnalogInput::AnalogInput;
@@ -97,10 +97,8 @@ double LightSound::micV2dB(double Voltage)
 
 void LightSound::readMic()
 {
-
-    constexpr uint16_t numSamples = 50;
-    uint64_t mic0_buf[numSamples] = {0};
-    uint64_t mic1_buf[numSamples] = {0};
+    int32_t mic0_buf[numMicSamples] = {0};
+    int32_t mic1_buf[numMicSamples] = {0};
 
     // set channel for mic
     adc_select_input(0);
@@ -110,7 +108,7 @@ void LightSound::readMic()
     #endif
 
     // read samples and average
-    for(uint16_t i = 0; i < numSamples; i++)
+    for(uint16_t i = 0; i < numMicSamples; i++)
     {
         uint64_t intermediate = 0;
         for(int i = 0; i < overSample; i++)
@@ -122,7 +120,7 @@ void LightSound::readMic()
 
     #if (_LOG_LEVEL >= 4)
     double period = (time_us_64() - start) / 1e6;  // total period in s
-    double samplePeriod = period / numSamples;  // in s
+    double samplePeriod = period / numMicSamples;  // in s
     double minFreq = 1 / period;  // in Hz
 
     xlog_debug("Mic captured in " << period << "s");
@@ -131,7 +129,7 @@ void LightSound::readMic()
     #endif // _LOG_LEVEL
 
     adc_select_input(1);
-    for(uint16_t i = 0; i < numSamples; i++)
+    for(uint16_t i = 0; i < numMicSamples; i++)
     {
         uint64_t intermediate = 0;
         for(int i = 0; i < overSample; i++)
@@ -141,65 +139,20 @@ void LightSound::readMic()
         mic1_buf[i] = intermediate / overSample;
     }
 
-    // calculate standard deviation    
-    double sumOfElements0 {0};
-    double sumOfSquaredErrors0 {0};
-    double mean0 {0};
-    double stdDev0 {0};
-    double min0 {static_cast<double>(mic0_buf[0])};
-    double max0 {static_cast<double>(mic0_buf[0])};
-    double sumOfElements1 {0};
-    double sumOfSquaredErrors1 {0};
-    double mean1 {0};
-    double stdDev1 {0};
-    double min1 {static_cast<double>(mic1_buf[0])};
-    double max1 {static_cast<double>(mic1_buf[0])};
-    
     #if (_LOG_LEVEL >= 4)
     start = time_us_64();
     #endif
 
-    for(int i=0; i<numSamples; i++)
-    {
-        auto el0 = mic0_buf[i];
-        auto el1 = mic1_buf[i];
-        sumOfElements0 += el0;
-        sumOfElements1 += el1;
-
-        if(el0 < min0)
-        {
-            min0 = el0;
-        }
-
-        if(el1 < min1)
-        {
-            min1 = el1;
-        }
+    // each block replaces the whole window, statistics are of this block only
+    mic0Statistics.insertMany(mic0_buf, numMicSamples);
+    mic1Statistics.insertMany(mic1_buf, numMicSamples);
+    mic0Statistics.updateStatistics();
+    mic1Statistics.updateStatistics();
 
-        if(el0 > max0)
-        {
-            max0 = el0;
-        }
-
-        if(el1 > max1)
-        {
-            max1 = el1;
-        }
-    }
-
-    // mean0 value of the elements in buffer
-    mean0 = sumOfElements0 / numSamples;
-    mean1 = sumOfElements1 / numSamples;
-
-    // standard deviation is calculated as the square root of the mean0 of the
-    // squared deviations from the mean0
-    for(int i=0; i<numSamples; i++)
-    {
-        sumOfSquaredErrors0 += powf(mic0_buf[i] - mean0, 2);
-        sumOfSquaredErrors1 += powf(mic1_buf[i] - mean1, 2);
-    }
-    stdDev0 = sqrtf(sumOfSquaredErrors0 / numSamples);
-    stdDev1 = sqrtf(sumOfSquaredErrors1 / numSamples);
+    float min0, max0, mean0, stdDev0;
+    float min1, max1, mean1, stdDev1;
+    mic0Statistics.getStatistics(&min0, &max0, &mean0, &stdDev0);
+    mic1Statistics.getStatistics(&min1, &max1, &mean1, &stdDev1);
 
     #if (_LOG_LEVEL >= 4)
     xlog_debug("Calculated in " << (time_us_64() - start) / 1e3f << "ms");
@@ -210,7 +163,7 @@ void LightSound::readMic()
         ss << mic0_buf[i] << ", ";
     }
     ss << "... ";
-    for(uint16_t i = numSamples - 10; i < numSamples; i++)
+    for(uint16_t i = numMicSamples - 10; i < numMicSamples; i++)
     {
         ss << ", " << mic0_buf[i];
     }
@@ -2,12 +2,14 @@
 #define __LIGHT_SOUND_HPP
 
 #include "Sensors/Sensor.hpp"
+#include "Buffer/StatisticBuffer.hpp"
 #include <string>
 
 namespace Xerxes
 {
     
-class LightSound : public Sensor
+/// @brief Light and sound levels, process values never go to the window so it keeps no order statistics
+class LightSound : public Sensor<PvStatistics<ORDER_NONE>>
 {
 private:
     typedef Sensor super;
@@ -33,6 +35,12 @@ private:
     uint8_t effectiveBitDepth       = rpBitDepth + oversampleBits;  // effective bit depth, 12 + 3 = 15
     uint64_t numCounts              = 1 << effectiveBitDepth;   // number of counts, 2^15 = 32768
 
+    constexpr static uint16_t numMicSamples = 50;              // samples of the microphones per update
+
+    // statistics of the last block of microphone samples, in ADC counts
+    StatisticBuffer<int32_t, numMicSamples, int64_t> mic0Statistics;
+    StatisticBuffer<int32_t, numMicSamples, int64_t> mic1Statistics;
+
     constexpr static uint32_t _updateRateHz = 20;  // update frequency in Hz
     constexpr static uint32_t _updateRateUs = _usInS / _updateRateHz;  // update rate in microseconds
 
@@ -23,15 +23,11 @@ void DS18B20::init(int _numChannels)
     _label = "DS18B20 temperature sensor -55°C to +125°C";           // device label
     numChannels = _numChannels;
     xlog_info("Initializing DS18B20 using " << numChannels << " channels");
+    setChannelMask((1 << numChannels) - 1);
     
     // set update rate
     *_reg->desiredCycleTimeUs = _updateRateUs;
 
-    rbpv0 = StatisticBuffer<float>(_updateRateHz * 5);
-    rbpv1 = StatisticBuffer<float>(_updateRateHz * 5);
-    rbpv2 = StatisticBuffer<float>(_updateRateHz * 5);
-    rbpv3 = StatisticBuffer<float>(_updateRateHz * 5);
-
     // enable power supply to sensor
     gpio_init(EXT_3V3_EN_PIN);
     gpio_set_dir(EXT_3V3_EN_PIN, GPIO_OUT);
@@ -89,42 +85,19 @@ void DS18B20::update()
         // do nothing
     }
 
-    // if calcStat is true, update statistics
-    if(_reg->config->bits.calcStat)
-    {
-        // insert new values into ring buffer
-        rbpv0.insertOne(*_reg->pv0);
-
-        // update statistics
-        rbpv0.updateStatistics();
-
-        // update min, max stddev etc...
-        rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, nullptr, _reg->stdDevPv0, _reg->meanPv0);
-    }
-
-    // if calcStat is true and numChannels > 1, update statistics for pv1
-    if(_reg->config->bits.calcStat && numChannels > 1)
-    {
-        rbpv1.insertOne(*_reg->pv1);
-        rbpv1.updateStatistics();
-        rbpv1.getStatistics(_reg->minPv1, _reg->maxPv1, nullptr, _reg->stdDevPv1, _reg->meanPv1);
-    }
+    // if calcStat is true, insert used channels into the statistics
+    insertSamples();
+}
 
-    // if calcStat is true and numChannels > 2, update statistics for pv2
-    if(_reg->config->bits.calcStat && numChannels > 2)
-    {
-        rbpv2.insertOne(*_reg->pv2);
-        rbpv2.updateStatistics();
-        rbpv2.getStatistics(_reg->minPv2, _reg->maxPv2, nullptr, _reg->stdDevPv2, _reg->meanPv2);
-    }
 
-    // if calcStat is true and numChannels > 3, update statistics for pv3
-    if(_reg->config->bits.calcStat && numChannels > 3)
-    {
-        rbpv3.insertOne(*_reg->pv3);
-        rbpv3.updateStatistics();
-        rbpv3.getStatistics(_reg->minPv3, _reg->maxPv3, nullptr, _reg->stdDevPv3, _reg->meanPv3);
-    }
+void DS18B20::publishStatistics()
+{
+    // update min, max stddev etc..., median is published as mean
+    pvStatistics.updateStatistics();
+    pvStatistics.getStatistics(_reg->minPv0, _reg->maxPv0, nullptr, _reg->stdDevPv0, _reg->meanPv0);
+    pvStatistics.getPercentiles(_reg->p5Pv0, _reg->p50Pv0, _reg->p95Pv0);
+    pvStatistics.getTrend(_reg->slopePv0, nullptr, _sInHour);
+    pvStatistics.getCovariance(_reg->covariance);
 }
 
 
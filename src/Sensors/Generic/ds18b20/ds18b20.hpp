@@ -6,7 +6,7 @@
 namespace Xerxes
 {
 
-class DS18B20: public Sensor
+class DS18B20: public Sensor<PvStatistics<ORDER_ALL>>
 {
 private:
     /// @brief convenience typedef
@@ -27,6 +27,9 @@ public:
     void init(int num_channels);
     void init();
     void update();
+
+    /// @brief Publish statistics of the ring buffers to the register
+    void publishStatistics() override;
     void stop();
         
     /**
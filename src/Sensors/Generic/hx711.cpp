@@ -61,12 +61,13 @@ void HX711::init()
 
 {
     _devid = DEVID_STRAIN_24BIT;
+
+    // single channel on pv0
+    setChannelMask(0b0001);
     
     // change sample rate to 10Hz
     *_reg->desiredCycleTimeUs = _sensorUpdateRateUs;
 
-    rbpv0 = StatisticBuffer<float>(_sensorFreqHz);
-
     // turn on 3.3V supply
     gpio_init(EXT_3V3_EN_PIN);
     gpio_set_dir(EXT_3V3_EN_PIN, GPIO_OUT);
@@ -83,20 +84,11 @@ void HX711::init()
 void HX711::update()
 {
     // read hx711 adc
-    *_reg->pv0 = this->read();
-
-    // if calcStat is true, update statistics
-    if(_reg->config->bits.calcStat)
-    {
-        // insert new values into ring buffer
-        rbpv0.insertOne(*_reg->pv0);
-
-        // update statistics
-        rbpv0.updateStatistics();
+    const int32_t counts = this->read();
+    *_reg->pv0 = counts;
 
-        // update min, max stddev etc...
-        rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
-    }
+    // if calcStat is true, insert counts into the statistics
+    insertSamples();
 }
 
 
@@ -9,7 +9,7 @@ namespace Xerxes
 /**
  * @brief HX711 ADC
  */ 
-class HX711 : public Sensor
+class HX711 : public Sensor<CountStatistics<1, ORDER_ALL>>
 {
 private:
     /// @brief convenience typedef
@@ -39,6 +39,7 @@ public:
     int32_t read();
     
     void update();
+
     void stop();
 
     std::string getJson();
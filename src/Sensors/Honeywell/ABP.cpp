@@ -28,6 +28,9 @@ void ABP::init()
 {    
     _devid = DEVID_PRESSURE_60MBAR;
 
+    // pv2 is not used
+    setChannelMask(0b1011);
+
     // init spi with freq 800kHz, return actual frequency
     uint baudrate = spi_init(spi0, 800'000);
     xlog_info("ABP spi init, baudrate: " << baudrate);
@@ -104,24 +107,8 @@ void ABP::update()
 
     xlog_debug("ABP p: " << *_reg->pv0 << "[Pa] = " << *_reg->pv1 << "[mmMPG], t: " << *_reg->pv3 << "[°C]");
 
-    // if calcStat is true, update statistics
-    if(_reg->config->bits.calcStat)
-    {
-        // insert new values into ring buffer
-        rbpv0.insertOne(*_reg->pv0);
-        rbpv1.insertOne(*_reg->pv1);
-        rbpv3.insertOne(*_reg->pv3);
-
-        // update statistics
-        rbpv0.updateStatistics();
-        rbpv1.updateStatistics();
-        rbpv3.updateStatistics();
-
-        // update min, max stddev etc...
-        rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
-        rbpv1.getStatistics(_reg->minPv1, _reg->maxPv1, _reg->meanPv1, _reg->stdDevPv1);
-        rbpv3.getStatistics(_reg->minPv3, _reg->maxPv3, _reg->meanPv3, _reg->stdDevPv3);
-    }
+    // if calcStat is true, insert pv0, pv1 and pv3 into the statistics
+    insertSamples();
 }
 
 
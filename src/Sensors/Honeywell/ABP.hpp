@@ -61,7 +61,7 @@ constexpr float Pmax    = 6000.0;    // Pa
 
 //TODO: temperature compensation for density of monopropylene glycol (MPG)
 
-class ABP : public Sensor
+class ABP : public Sensor<PvStatistics<ORDER_ALL>>
 {
 protected:
     // typedef Sensor as super class for easier access
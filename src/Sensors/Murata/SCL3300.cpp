@@ -42,6 +42,9 @@ void SCL3300::init()
 {    
     _devid = DEVID_ANGLE_XY_90;
 
+    // pv2 is not used
+    setChannelMask(0b1011);
+
     constexpr uint spi_freq = 2 * MHZ;
     // init spi with freq , return actual frequency
     uint baudrate = spi_init(spi0, spi_freq);
@@ -112,24 +115,8 @@ void SCL3300::update()
     uint16_t raw_temp = (uint16_t)(packetT->DATA_H << 8) + packetT->DATA_L;
     *_reg->pv3 = -273 + (static_cast<float>(raw_temp) / 18.9);
 
-    // if calcStat is true, update statistics
-    if(_reg->config->bits.calcStat)
-    {
-        // insert new values into ring buffer
-        rbpv0.insertOne(*_reg->pv0);
-        rbpv1.insertOne(*_reg->pv1);
-        rbpv3.insertOne(*_reg->pv3);
-
-        // update statistics
-        rbpv0.updateStatistics();
-        rbpv1.updateStatistics();
-        rbpv3.updateStatistics();
-
-        // update min, max stddev etc...
-        rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
-        rbpv1.getStatistics(_reg->minPv1, _reg->maxPv1, _reg->meanPv1, _reg->stdDevPv1);
-        rbpv3.getStatistics(_reg->minPv3, _reg->maxPv3, _reg->meanPv3, _reg->stdDevPv3);
-    }
+    // if calcStat is true, insert pv0, pv1 and pv3 into the statistics
+    insertSamples();
 }
 
 
@@ -45,11 +45,6 @@ void SCL3300a::init()
     // set cycle frequency to 70Hz
     *_reg->desiredCycleTimeUs = 1000000 / sensor_freq_hz;  // 70Hz
 
-    rbpv0 = StatisticBuffer<float>(sensor_freq_hz);
-    rbpv1 = StatisticBuffer<float>(sensor_freq_hz);
-    rbpv2 = StatisticBuffer<float>(sensor_freq_hz);
-    rbpv3 = StatisticBuffer<float>(sensor_freq_hz);
-
     constexpr uint spi_freq = 2 * MHZ;
     // init spi with freq , return actual frequency
     uint baudrate = spi_init(spi0, spi_freq);
@@ -111,35 +106,23 @@ void SCL3300a::update()
     uint16_t raw_temp = (uint16_t)(packetT->DATA_H << 8) + packetT->DATA_L;
     *_reg->pv3 = -273 + (static_cast<float>(raw_temp) / 18.9);
 
-    // if calcStat is true, update statistics
-    if(_reg->config->bits.calcStat)
-    {
-        // insert new values into ring buffer
-        rbpv0.insertOne(*_reg->pv0);
-        rbpv1.insertOne(*_reg->pv1);
-        rbpv2.insertOne(*_reg->pv2);
-        rbpv3.insertOne(*_reg->pv3);
-
-        // update statistics
-        rbpv0.updateStatistics();
-        rbpv1.updateStatistics();
-        rbpv2.updateStatistics();
-        rbpv3.updateStatistics();
-
-        // update min, max stddev etc...
-        rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
-        rbpv1.getStatistics(_reg->minPv1, _reg->maxPv1, _reg->meanPv1, _reg->stdDevPv1);
-        rbpv2.getStatistics(_reg->minPv2, _reg->maxPv2, _reg->meanPv2, _reg->stdDevPv2);
-        rbpv3.getStatistics(_reg->minPv3, _reg->maxPv3, _reg->meanPv3, _reg->stdDevPv3);
-        
-        *_reg->av0 = *_reg->stdDevPv0 * SQRT2;
-        *_reg->av1 = *_reg->stdDevPv1 * SQRT2;
-        *_reg->av2 = *_reg->stdDevPv2 * SQRT2;
-        
-        // calculate normal vector from 3 axis std dev
-        double normal_stdev = sqrt(pow(*_reg->stdDevPv0, 2) + pow(*_reg->stdDevPv1, 2) + pow(*_reg->stdDevPv2, 2));
-        *_reg->av3 = normal_stdev * SQRT2;
-    }
+    // if calcStat is true, insert new values into ring buffers
+    super::update();
+}
+
+
+void SCL3300a::publishStatistics()
+{
+    super::publishStatistics();
+
+    // amplitude of the vibrations from std dev
+    *_reg->av0 = *_reg->stdDevPv0 * SQRT2;
+    *_reg->av1 = *_reg->stdDevPv1 * SQRT2;
+    *_reg->av2 = *_reg->stdDevPv2 * SQRT2;
+    
+    // calculate normal vector from 3 axis std dev
+    double normal_stdev = sqrt(pow(*_reg->stdDevPv0, 2) + pow(*_reg->stdDevPv1, 2) + pow(*_reg->stdDevPv2, 2));
+    *_reg->av3 = normal_stdev * SQRT2;
 }
 
 
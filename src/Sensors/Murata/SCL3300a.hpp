@@ -46,6 +46,9 @@ public:
     void init();
     void update();
 
+    /// @brief Publish statistics of the ring buffers to the register
+    void publishStatistics() override;
+
 
     std::string getJson();
     std::string getJsonAmplitude();
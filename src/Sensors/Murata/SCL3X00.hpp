@@ -76,7 +76,7 @@ typedef enum
 
 
 
-class SCL3X00 : public Sensor
+class SCL3X00 : public Sensor<PvStatistics<ORDER_ALL>>
 {
 protected:
     typedef Sensor super;
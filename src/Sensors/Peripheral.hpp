@@ -3,12 +3,15 @@
 
 #include <cstdint>
 #include <DeviceIds.h>
+#include <functional>
 #include <ostream>
 #include <string>
 
 namespace Xerxes
 {
 
+    struct PvSnapshot;
+
     /**
      * @brief Check if the data received from the spi bus is valid
      *
@@ -30,6 +33,7 @@ namespace Xerxes
         devid_t _devid{0};
 
         constexpr static uint32_t _usInS = 1000000; // microseconds in a second
+        constexpr static uint32_t _sInHour = 3600;  // seconds in an hour, time unit of the slopes
         std::string _label{"Xerxes Peripheral"};
 
     public:
@@ -51,6 +55,34 @@ namespace Xerxes
         virtual std::string getJson() = 0;
 
         virtual std::string getInfoJson() const = 0;
+
+        /**
+         * @brief Publish statistics which are out of date, see Sensor
+         *
+         * Peripherals without statistics have nothing to publish.
+         *
+         * @return true if anything was published
+         */
+        virtual bool refreshStatistics() { return false; }
+
+        /**
+         * @brief Take the process values with their statistics from one cycle, see Sensor
+         *
+         * Overrides fill the snapshot passed in, this one leaves it untouched.
+         *
+         * @return false if the peripheral has nothing consistent to offer, the
+         *  caller reads the register instead, see Register::readSnapshot()
+         */
+        virtual bool snapshot(PvSnapshot &) { return false; }
+
+        /**
+         * @brief Read the register while its statistics can not change, see Sensor
+         *
+         * Peripherals without statistics just call read.
+         *
+         * @param read - copies what it needs from the register, must not block
+         */
+        virtual void readStatistics(const std::function<void()> &read) { read(); }
     };
 
 } // namespace Xerxes
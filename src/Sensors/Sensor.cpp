@@ -1,44 +1,336 @@
 #include "Sensor.hpp"
+#include <algorithm>
 #include <bitset>
+#include <cmath>
+#include <sstream>
+#include <utility>
+#include "pico/time.h"
 
 namespace Xerxes
 {
 
-    Sensor::Sensor(Register *reg) : _reg(reg)
+    SensorBase::SensorBase(Register *reg) : _reg(reg)
     {
-        // initialize ringbuffer with size of RING_BUFFER_LEN (defined in Definitions.h)
-        rbpv0 = StatisticBuffer<float>(RING_BUFFER_LEN);
-        rbpv1 = StatisticBuffer<float>(RING_BUFFER_LEN);
-        rbpv2 = StatisticBuffer<float>(RING_BUFFER_LEN);
-        rbpv3 = StatisticBuffer<float>(RING_BUFFER_LEN);
+        critical_section_init(&statisticsLock);
     }
 
-    void Sensor::update()
+    SensorBase::SensorBase() : SensorBase(nullptr)
     {
+    }
+
+    void SensorBase::update()
+    {
+        insertSamples();
+    }
+
+    void SensorBase::setChannelMask(const uint8_t &mask)
+    {
+        critical_section_enter_blocking(&statisticsLock);
+        channelMask = mask;
+        setWindowChannelMask(mask);
+        ewStatistics.setChannelMask(mask);
+        outlierFilter.setChannelMask(mask);
+        for (auto &window : windows)
+        {
+            window.clear();
+        }
+        for (auto &histogram : histograms)
+        {
+            histogram.clear();
+        }
+        for (auto &deviation : allan)
+        {
+            deviation.clear();
+        }
+        critical_section_exit(&statisticsLock);
+    }
+
+    void SensorBase::insertSamples()
+    {
+        const bool calcStat = _reg->config->bits.calcStat;
+        const uint64_t now = time_us_64();
+
+        critical_section_enter_blocking(&statisticsLock);
+        std::copy(_reg->pv0, _reg->pv0 + cyclePv.size(), cyclePv.begin());
+        cycleUs = now;
+
         // if calcStat is true, update statistics
-        if (_reg->config->bits.calcStat)
+        if (calcStat)
+        {
+            const bool ewMode = _reg->config->all & MASK_CONFIG_EW_STATS;
+
+            samples = cyclePv;
+            rejectOutliers();
+
+            if (ewMode)
+            {
+                // restart when the mode is switched on, alpha follows the cycle time
+                if (!exponential)
+                {
+                    ewStatistics.clear();
+                }
+                ewStatistics.setTimeConstant(static_cast<uint64_t>(*_reg->ewTimeConstantMs) * 1000, *_reg->desiredCycleTimeUs);
+                ewStatistics.insert(samples.data());
+            }
+            else
+            {
+                insertWindow(now);
+            }
+            exponential = ewMode;
+
+            // a snapshot before commitSamples() must not pair cyclePv with the old statistics
+            statisticsDirty = true;
+        }
+        critical_section_exit(&statisticsLock);
+
+        if (calcStat)
+        {
+            commitSamples(now);
+        }
+    }
+
+    void SensorBase::rejectOutliers()
+    {
+        const bool reject = _reg->config->all & MASK_CONFIG_REJECT_OUTLIERS;
+
+        // window of the last run is stale
+        if (reject && !rejecting)
+        {
+            outlierFilter.clear();
+            outlierFilter.setThreshold(HAMPEL_THRESHOLD);
+        }
+        rejecting = reject;
+        if (!reject)
+        {
+            return;
+        }
+
+        // rejectedPv0..3 are consecutive in the register
+        const uint8_t outliers = outlierFilter.filter(samples.data());
+        for (uint8_t ch = 0; ch < samples.size(); ch++)
+        {
+            if (outliers & (1u << ch))
+            {
+                _reg->rejectedPv0[ch]++;
+            }
+        }
+    }
+
+    uint32_t SensorBase::windowUs() const
+    {
+        // saturate, windows are limited to ~35 min anyway
+        return std::min<uint64_t>(static_cast<uint64_t>(*_reg->statisticsWindowMs) * 1000, UINT32_MAX);
+    }
+
+    void SensorBase::commitSamples(const uint64_t &timeUs)
+    {
+        const float histogramMin = *_reg->histogramMin;
+        const float histogramWidth = *_reg->histogramWidth;
+        const uint8_t enabled = _reg->config->all & (MASK_CONFIG_WINDOWS | MASK_CONFIG_HISTOGRAMS | MASK_CONFIG_ALLAN);
+        const bool windowsOn = enabled & MASK_CONFIG_WINDOWS;
+        const bool histogramsOn = enabled & MASK_CONFIG_HISTOGRAMS;
+        const bool allanOn = enabled & MASK_CONFIG_ALLAN;
+
+        critical_section_enter_blocking(&statisticsLock);
+
+        // samples from before a pause do not belong to the new ones
+        const uint8_t switchedOn = enabled & ~optionalStatistics;
+        optionalStatistics = enabled;
+        for (uint8_t ch = 0; ch < windows.size(); ch++)
+        {
+            if (switchedOn & MASK_CONFIG_WINDOWS)
+            {
+                windows[ch].clear();
+            }
+            if (switchedOn & MASK_CONFIG_HISTOGRAMS)
+            {
+                histograms[ch].clear();
+            }
+            if (switchedOn & MASK_CONFIG_ALLAN)
+            {
+                allan[ch].clear();
+            }
+        }
+
+        for (uint8_t ch = 0; ch < windows.size(); ch++)
+        {
+            if (!(channelMask & (1u << ch)))
+            {
+                continue;
+            }
+
+            if (windowsOn)
+            {
+                windowsDirty |= windows[ch].insert(samples[ch], timeUs);
+            }
+            if (histogramsOn)
+            {
+                // counts of the old range are meaningless for the new one
+                if (!histograms[ch].hasRange(histogramMin, histogramWidth))
+                {
+                    histograms[ch].setRange(histogramMin, histogramWidth);
+                }
+                histograms[ch].insert(samples[ch]);
+            }
+            if (allanOn)
+            {
+                allanDirty |= allan[ch].insert(samples[ch], timeUs);
+            }
+        }
+
+        // features switched off are not published any more
+        windowsDirty = windowsDirty && windowsOn;
+        histogramsDirty = histogramsOn;
+        allanDirty = allanDirty && allanOn;
+        statisticsDirty = true;
+        critical_section_exit(&statisticsLock);
+
+        if (!(_reg->config->all & MASK_CONFIG_LAZY_STATS))
         {
-            // insert new values into ring buffer
-            rbpv0.insertOne(*_reg->pv0);
-            rbpv1.insertOne(*_reg->pv1);
-            rbpv2.insertOne(*_reg->pv2);
-            rbpv3.insertOne(*_reg->pv3);
+            refreshStatistics();
+        }
+    }
 
-            // update statistics
-            rbpv0.updateStatistics();
-            rbpv1.updateStatistics();
-            rbpv2.updateStatistics();
-            rbpv3.updateStatistics();
+    bool SensorBase::refreshStatistics()
+    {
+        critical_section_enter_blocking(&statisticsLock);
+        const bool published = publishDirty();
+        critical_section_exit(&statisticsLock);
+        return published;
+    }
 
-            // update min, max stddev etc...
-            rbpv0.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
-            rbpv1.getStatistics(_reg->minPv1, _reg->maxPv1, _reg->meanPv1, _reg->stdDevPv1);
-            rbpv2.getStatistics(_reg->minPv2, _reg->maxPv2, _reg->meanPv2, _reg->stdDevPv2);
-            rbpv3.getStatistics(_reg->minPv3, _reg->maxPv3, _reg->meanPv3, _reg->stdDevPv3);
+    bool SensorBase::snapshot(PvSnapshot &out)
+    {
+        critical_section_enter_blocking(&statisticsLock);
+        publishDirty();
+        _reg->readSnapshot(out, cycleUs ? cycleUs : time_us_64());
+        if (cycleUs)
+        {
+            std::copy(cyclePv.begin(), cyclePv.end(), out.pv);
+        }
+        critical_section_exit(&statisticsLock);
+        return true;
+    }
+
+    void SensorBase::readStatistics(const std::function<void()> &read)
+    {
+        critical_section_enter_blocking(&statisticsLock);
+        publishDirty();
+        read();
+        critical_section_exit(&statisticsLock);
+    }
+
+    bool SensorBase::publishDirty()
+    {
+        const bool dirty = statisticsDirty || windowsDirty || histogramsDirty || allanDirty;
+        if (statisticsDirty)
+        {
+            statisticsDirty = false;
+            if (exponential)
+            {
+                publishExponential();
+            }
+            else
+            {
+                publishStatistics();
+            }
+        }
+        if (windowsDirty)
+        {
+            windowsDirty = false;
+            publishWindows();
+        }
+        if (histogramsDirty)
+        {
+            histogramsDirty = false;
+            publishHistograms();
+        }
+        if (allanDirty)
+        {
+            allanDirty = false;
+            publishAllan();
+        }
+        return dirty;
+    }
+
+    void SensorBase::publishWindows()
+    {
+        using Resolution = CascadedStatistics<float>::Resolution;
+
+        const std::pair<Resolution, StatisticsBlock *> blocks[] = {
+            {Resolution::SECOND, _reg->window1s},
+            {Resolution::TEN_SECONDS, _reg->window10s},
+            {Resolution::MINUTE, _reg->window60s}};
+
+        for (const auto &[resolution, block] : blocks)
+        {
+            for (uint8_t ch = 0; ch < windows.size(); ch++)
+            {
+                if (channelMask & (1u << ch))
+                {
+                    windows[ch].getStatistics(resolution, &block->mean[ch], &block->stdDev[ch], &block->min[ch], &block->max[ch]);
+                }
+            }
+        }
+    }
+
+    void SensorBase::publishHistograms()
+    {
+        HistogramBlock *block = _reg->histogram;
+        for (uint8_t ch = 0; ch < histograms.size(); ch++)
+        {
+            if (channelMask & (1u << ch))
+            {
+                const auto &bins = histograms[ch].getBins();
+                std::copy(bins.begin(), bins.end(), block->bins[ch]);
+                block->underflow[ch] = histograms[ch].getUnderflow();
+                block->overflow[ch] = histograms[ch].getOverflow();
+            }
+        }
+    }
+
+    void SensorBase::publishAllan()
+    {
+        for (uint8_t ch = 0; ch < allan.size(); ch++)
+        {
+            if (channelMask & (1u << ch))
+            {
+                allan[ch].getDeviation(_reg->allan->deviation[ch]);
+            }
+        }
+    }
+
+    void SensorBase::publishExponential()
+    {
+        ewStatistics.getStatistics(_reg->meanPv0, _reg->stdDevPv0);
+
+        // there is no window in this mode
+        for (float *block : {_reg->minPv0, _reg->maxPv0, _reg->p5Pv0, _reg->p50Pv0, _reg->p95Pv0, _reg->slopePv0})
+        {
+            for (uint8_t ch = 0; ch < 4; ch++)
+            {
+                if (channelMask & (1u << ch))
+                {
+                    block[ch] = NAN;
+                }
+            }
+        }
+
+        // upper triangle row by row, same entries as the window would write
+        float *covariance = _reg->covariance;
+        for (uint8_t x = 0; x < 4; x++)
+        {
+            for (uint8_t y = x; y < 4; y++, covariance++)
+            {
+                if ((channelMask & (1u << x)) && (channelMask & (1u << y)))
+                {
+                    *covariance = NAN;
+                }
+            }
         }
     }
 
-    std::string Sensor::getInfoJson() const
+    std::string SensorBase::getInfoJson() const
     {
         auto gain0 = (float)*_reg->gainPv0;
         auto gain1 = (float)*_reg->gainPv1;
@@ -3,20 +3,42 @@
 
 #include "Core/Register.hpp"
 #include "Sensors/Peripheral.hpp"
-#include "Buffer/StatisticBuffer.hpp"
+#include "Buffer/MultiChannelStatistics.hpp"
+#include "Buffer/ExponentialStatistics.hpp"
+#include "Buffer/CascadedStatistics.hpp"
+#include "Buffer/Histogram.hpp"
+#include "Buffer/AllanDeviation.hpp"
+#include "Buffer/HampelFilter.hpp"
 #include "Core/Definitions.h"
 #include "hardware/gpio.h"
 #include "hardware/spi.h"
 #include "hardware/adc.h"
+#include "pico/critical_section.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace Xerxes
 {
 
+    /// @brief Statistics of the process values pv0..pv3 over a window of RING_BUFFER_LEN samples, Order see OrderStatistics
+    template <uint8_t Order>
+    using PvStatistics = MultiChannelStatistics<4, float, RING_BUFFER_LEN, double, Order>;
+
+    /// @brief Statistics of raw ADC counts, integer sums, float only when published
+    template <uint32_t NCh, uint8_t Order>
+    using CountStatistics = MultiChannelStatistics<NCh, int32_t, RING_BUFFER_LEN, int64_t, Order>;
+
     /**
-     * @brief Sensor class
+     * @brief Sensor without its window statistics, see Sensor
      *
+     * Holds everything the sensors share: outlier rejection, exponentially
+     * weighted statistics, the cascaded windows, histograms and Allan deviation,
+     * and the lazy publishing. The window is left to Sensor, so every device
+     * owns exactly the window it publishes.
      */
-    class Sensor : public Peripheral
+    class SensorBase : public Peripheral
     {
     protected:
         // typedef Peripheral as super class for easier access
@@ -24,15 +46,131 @@ namespace Xerxes
 
         Register *_reg;
 
-        // define ringbuffer (circular buffer) for each process value
-        /// @brief Ringbuffer for process value 0
-        StatisticBuffer<float> rbpv0;
-        /// @brief Ringbuffer for process value 1
-        StatisticBuffer<float> rbpv1;
-        /// @brief Ringbuffer for process value 2
-        StatisticBuffer<float> rbpv2;
-        /// @brief Ringbuffer for process value 3
-        StatisticBuffer<float> rbpv3;
+        /// @brief Process values with statistics, bit i for pv i, set by the device in init()
+        uint8_t channelMask {0b1111};
+
+        /// @brief exponentially weighted mean and stddev of pv0..pv3, see MASK_CONFIG_EW_STATS
+        ExponentialStatistics<4> ewStatistics;
+
+        /// @brief Samples of the last cycle went to ewStatistics instead of the window
+        bool exponential {false};
+
+        /// @brief Process values of this cycle as the statistics see them, outliers replaced
+        std::array<float, 4> samples {};
+
+        /// @brief Process values of the last cycle as they were sampled, for snapshot()
+        std::array<float, 4> cyclePv {};
+
+        /// @brief Time of the last cycle, 0 before the first one
+        uint64_t cycleUs {0};
+
+        /// @brief Outlier rejection of the process values, see MASK_CONFIG_REJECT_OUTLIERS
+        HampelFilter<4, float, HAMPEL_WINDOW> outlierFilter;
+
+        /// @brief Outlier rejection was on in the last cycle
+        bool rejecting {false};
+
+        /// @brief Guards the ringbuffers, samples are inserted on core1, statistics may be published from core0
+        critical_section_t statisticsLock;
+
+        /// @brief Samples were inserted since the statistics were last published
+        bool statisticsDirty {false};
+
+        /// @brief 1 s, 10 s and 60 s windows of the process values
+        std::array<CascadedStatistics<float>, 4> windows;
+
+        /// @brief A second was completed since the windows were last published
+        bool windowsDirty {false};
+
+        /// @brief Histograms of the process values, range from histogramMin and histogramWidth
+        std::array<Histogram<HISTOGRAM_BINS>, 4> histograms;
+
+        /// @brief Samples were counted since the histograms were last published
+        bool histogramsDirty {false};
+
+        /// @brief Allan deviation of the process values for tau = 1 s ... 4096 s
+        std::array<AllanDeviation<ALLAN_TAUS>, 4> allan;
+
+        /// @brief A block of the Allan deviation was completed since it was last published
+        bool allanDirty {false};
+
+        /// @brief Config bits of the windows, histograms and Allan deviation in the last cycle
+        uint8_t optionalStatistics {0};
+
+        /**
+         * @brief Select process values with statistics, drops collected samples
+         *
+         * @param mask - bit i set for pv i
+         */
+        void setChannelMask(const uint8_t &mask);
+
+        /**
+         * @brief Insert samples of this cycle into the statistics if calcStat is set and commit them
+         *
+         * Process values are kept in cyclePv for snapshot() and copied to samples, with MASK_CONFIG_REJECT_OUTLIERS
+         * outliers are replaced there and counted in rejectedPv0..3. Samples go
+         * to the window (insertWindow()) or, with MASK_CONFIG_EW_STATS, to the
+         * exponentially weighted statistics with alpha from ewTimeConstantMs
+         * and desiredCycleTimeUs.
+         */
+        void insertSamples();
+
+        /**
+         * @brief Insert the samples of this cycle into the window statistics
+         *
+         * Called with statisticsLock held.
+         *
+         * @param timeUs - time of the samples, evicts samples older than statisticsWindowMs
+         */
+        virtual void insertWindow(const uint64_t &timeUs) = 0;
+
+        /// @brief Select channels of the window statistics and drop their samples, with statisticsLock held
+        virtual void setWindowChannelMask(const uint8_t &mask) = 0;
+
+        /// @brief Replace outliers in samples and count them if MASK_CONFIG_REJECT_OUTLIERS is set, with statisticsLock held
+        void rejectOutliers();
+
+        /// @brief Length of the statistics window in us, 0 for RING_BUFFER_LEN samples
+        uint32_t windowUs() const;
+
+        /// @brief Write exponentially weighted mean and stddev to the register, window only values to NaN
+        void publishExponential();
+
+        /**
+         * @brief Finish a cycle after the samples taken at timeUs were inserted
+         *
+         * Folds the process values into the 1 s/10 s/60 s windows, the
+         * histograms (restarted when their range is changed) and the Allan
+         * deviation, each only if its config bit is set (MASK_CONFIG_WINDOWS,
+         * MASK_CONFIG_HISTOGRAMS, MASK_CONFIG_ALLAN) and restarted when it is
+         * switched on. Marks statistics out of date. Statistics are published right away, unless
+         * lazy statistics are enabled (MASK_CONFIG_LAZY_STATS). Then they wait
+         * for refreshStatistics() on register read or in idle time of core1.
+         */
+        void commitSamples(const uint64_t &timeUs);
+
+        /// @brief Write the 1 s/10 s/60 s windows to the register
+        void publishWindows();
+
+        /// @brief Write the histograms to the register
+        void publishHistograms();
+
+        /// @brief Write the Allan deviation to the register
+        void publishAllan();
+
+        /**
+         * @brief Publish what is out of date, with statisticsLock held
+         *
+         * @return true if anything was out of date
+         */
+        bool publishDirty();
+
+        /**
+         * @brief Compute statistics of the window and write them to the register
+         *
+         * Called with statisticsLock held, not used in exponentially weighted mode.
+         */
+        virtual void publishStatistics() = 0;
 
     public:
         using Peripheral::Peripheral;
@@ -42,19 +180,47 @@ namespace Xerxes
          *
          * @param reg pointer to the register where the sensor data is stored
          */
-        Sensor(Register *reg);
+        SensorBase(Register *reg);
 
         /**
          * @brief Construct a new Sensor object without register for declaration
          *
          */
-        Sensor() : _reg(nullptr){};
+        SensorBase();
 
         /**
          * @brief Update the sensor data
          */
         void update();
 
+        /**
+         * @brief Publish statistics if samples were inserted since they were last published
+         *
+         * @return true if anything was published
+         */
+        bool refreshStatistics() override;
+
+        /**
+         * @brief Process values of the last cycle with the statistics published for them
+         *
+         * Taken under statisticsLock with lazy statistics published first, core1
+         * can not start the next cycle halfway through the copy.
+         *
+         * @param out snapshot to fill
+         * @return true, falls back to the register before the first cycle
+         */
+        bool snapshot(PvSnapshot &out) override;
+
+        /**
+         * @brief Read the register under statisticsLock with lazy statistics published first
+         *
+         * Statistics read by several copies come from one cycle, process
+         * values are written outside of the lock and may be newer.
+         *
+         * @param read - copies what it needs from the register, must not block
+         */
+        void readStatistics(const std::function<void()> &read) override;
+
         /**
          * @brief Get the Info object
          *
@@ -63,6 +229,100 @@ namespace Xerxes
         std::string getInfoJson() const override;
     };
 
+    /**
+     * @brief Sensor with the window statistics of its process values
+     *
+     * The window is a policy, e.g. PvStatistics for process values in float
+     * or CountStatistics for raw ADC counts with exact integer sums. Samples
+     * are converted to the element type of the window on insert, integer
+     * windows take samples * countsPerUnit and publish with the inverse scale.
+     *
+     * Each device opts in to min/max and percentiles by the Order of its
+     * window, the registers of the statistics it does not keep read NaN. The
+     * window has to fit STATISTICS_RAM_BUDGET for the RING_BUFFER_LEN of the
+     * device.
+     *
+     * @tparam Window - MultiChannelStatistics of up to 4 channels, channel i holds pv i
+     */
+    template <class Window>
+    class Sensor : public SensorBase
+    {
+        static_assert(Window::Channels <= 4, "window holds pv0..pv3 at most");
+        static_assert(sizeof(Window) <= STATISTICS_RAM_BUDGET,
+                      "window statistics exceed STATISTICS_RAM_BUDGET, shorten RING_BUFFER_LEN or keep fewer OrderStatistics");
+
+    protected:
+        // typedef SensorBase as super class for easier access
+        typedef SensorBase super;
+
+        /// @brief Statistics of the process values over the window, fixed per device type at compile time
+        Window pvStatistics;
+
+        /// @brief Counts of an integer window per unit of the process value
+        float countsPerUnit {1};
+
+        /**
+         * @brief Keep an integer window in counts, published on the scale of the process values
+         *
+         * @param counts - counts per unit of the process value, e.g. 2^16 for pv in <0, 1)
+         */
+        void setCountsPerUnit(const float &counts)
+        {
+            countsPerUnit = counts;
+            pvStatistics.setScale(1.0f / counts);
+        }
+
+        void insertWindow(const uint64_t &timeUs) override
+        {
+            using Element = typename Window::Element;
+
+            Element el[Window::Channels];
+            for (uint8_t ch = 0; ch < Window::Channels; ch++)
+            {
+                if constexpr (std::is_integral_v<Element>)
+                {
+                    // counts have no NaN or inf, e.g. a ratio to a zero reference, the cycle is left out of the window
+                    const double counts = static_cast<double>(samples[ch]) * countsPerUnit;
+                    if (!std::isfinite(counts) && (pvStatistics.getChannelMask() & (1 << ch)))
+                    {
+                        return;
+                    }
+
+                    // counts are whole numbers in the float samples, outliers are replaced by one of them,
+                    // out of range values saturate instead of overflowing the conversion
+                    constexpr double lowest = std::numeric_limits<Element>::lowest();
+                    constexpr double highest = std::numeric_limits<Element>::max();
+                    el[ch] = std::isfinite(counts) ? static_cast<Element>(std::lrint(std::clamp(counts, lowest, highest))) : 0;
+                }
+                else
+                {
+                    el[ch] = samples[ch];
+                }
+            }
+            pvStatistics.setWindowUs(windowUs());
+            pvStatistics.insert(el, timeUs);
+        }
+
+        void setWindowChannelMask(const uint8_t &mask) override
+        {
+            pvStatistics.setChannelMask(mask);
+        }
+
+        void publishStatistics() override
+        {
+            pvStatistics.updateStatistics();
+
+            // MEAN, STDDEV, MIN, MAX and P5, P50, P95 blocks hold pv0..pv3 consecutively
+            pvStatistics.getStatistics(_reg->minPv0, _reg->maxPv0, _reg->meanPv0, _reg->stdDevPv0);
+            pvStatistics.getPercentiles(_reg->p5Pv0, _reg->p50Pv0, _reg->p95Pv0);
+            pvStatistics.getTrend(_reg->slopePv0, nullptr, _sInHour);
+            pvStatistics.getCovariance(_reg->covariance);
+        }
+
+    public:
+        using SensorBase::SensorBase;
+    };
+
 } // namespace Xerxes
 
 #endif // !__SENSOR_HPP
@@ -3,10 +3,8 @@
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
 #include "hardware/watchdog.h"
-#include "pico/util/queue.h"
 
 #include "Core/Errors.h"
-#include "Core/BindWrapper.hpp"
 #include "Core/Slave.hpp"
 #include "Core/Register.hpp"
 #include "Communication/Callbacks.hpp"
@@ -24,20 +22,35 @@
 using namespace std;
 using namespace Xerxes;
 
-// forward declaration
-__DEVICE_CLASS device;
-
 Register _reg; // main register
 
-/// @brief transmit FIFO queue for UART
-queue_t txFifo;
-/// @brief receive FIFO queue for UART
-queue_t rxFifo;
+// device is constructed in place, it holds the statistic buffers and is too
+// large to be copied over the stack
+__DEVICE_CLASS device(&_reg);
+
+/// @brief transmit ring for UART, read by DMA
+UartTxRing txRing;
+/// @brief receive ring for UART, filled by DMA
+UartRxRing rxRing;
 
-RS485 xn(&txFifo, &rxFifo); // RS485 interface
+RS485 xn(&txRing, &rxRing); // RS485 interface
 Protocol xp(&xn);           // Xerxes protocol implementation
 Slave xs;
 
+/// @brief message handlers with their address filter, sorted at compile time
+constexpr auto routes = makeDispatchTable({
+    {MSGID_PING, Target::UNICAST, pingCallback},
+    {MSGID_WRITE, Target::UNICAST, writeRegCallback},
+    {MSGID_READ, Target::UNICAST, readRegCallback},
+    {MSGID_READ_MULTI, Target::UNICAST, readMultiCallback},
+    {MSGID_PV_SNAPSHOT, Target::UNICAST, pvSnapshotCallback},
+    {MSGID_SYNC, Target::BROADCAST, syncCallback},
+    {MSGID_SLEEP, Target::BROADCAST, sleepCallback},
+    {MSGID_RESET_SOFT, Target::BROADCAST, softResetCallback},
+    {MSGID_RESET_HARD, Target::UNICAST, factoryResetCallback},
+    {MSGID_GET_INFO, Target::UNICAST, getSensorInfoCallback},
+});
+
 volatile bool usrSwitchOn;      // user switch state
 volatile bool core1idle = true; // core1 idle flag
 volatile bool useUsb = false;   // use usb uart flag
@@ -54,7 +67,7 @@ int main(void)
 
     // init system
     userInit();                        // 374us
-    xs = Slave(&xp, *_reg.devAddress); ///< Xerxes slave implementation
+    xs = Slave(&xp, _reg.devAddress); ///< Xerxes slave implementation
 
     // blink led for 10 ms - we are alive
     gpio_put(USR_LED_PIN, 1);
@@ -90,7 +103,6 @@ int main(void)
     }
 
     watchdog_update();
-    device = __DEVICE_CLASS(&_reg);
     try
     {
         device.init();
@@ -125,21 +137,11 @@ int main(void)
         userInitUart();
     }
 
-    // bind callbacks, ~204us
-    xs.bind(MSGID_PING, unicast(pingCallback));
-    xs.bind(MSGID_WRITE, unicast(writeRegCallback));
-    xs.bind(MSGID_READ, unicast(readRegCallback));
-    xs.bind(MSGID_SYNC, broadcast(syncCallback));
-    xs.bind(MSGID_SLEEP, broadcast(sleepCallback));
-    xs.bind(MSGID_RESET_SOFT, broadcast(softResetCallback));
-    xs.bind(MSGID_RESET_HARD, unicast(factoryResetCallback));
-    xs.bind(MSGID_GET_INFO, unicast(getSensorInfoCallback));
-
-    // drain uart fifos, just in case there is something in there
-    while (!queue_is_empty(&txFifo))
-        queue_remove_blocking(&txFifo, NULL);
-    while (!queue_is_empty(&rxFifo))
-        queue_remove_blocking(&rxFifo, NULL);
+    // route callbacks, the table is built at compile time
+    xs.route(routes);
+
+    // drain uart rx ring, just in case there is something in there
+    rxRing.flush();
 
     // start core1 for device operation
     multicore_launch_core1(core1Entry);
@@ -162,7 +164,8 @@ int main(void)
             cout << "\"netCycleTimeUs\":" << *_reg.netCycleTimeUs << "," << endl;
             cout << "\"errors\": 0b" << bitset<32>(*_reg.error) << ",\n";
 
-            // cout device values in json format
+            // cout device values in json format, publish lazy statistics first
+            device.refreshStatistics();
             cout << "\"device\":" << device.getJson() << endl;
             cout << "}" << endl
                  << endl;
@@ -176,30 +179,14 @@ int main(void)
         }
         else
         {
-            // running on RS485, sync for incoming messages from master, timeout = 5ms
-            xs.sync(5000);
-
-            // send char if tx queue is not empty and uart is writable
-            if (!queue_is_empty(&txFifo))
-            {
-                uint txLen = queue_get_level(&txFifo);
-                assert(txLen <= RX_TX_QUEUE_SIZE);
-
-                uint8_t toSend[txLen];
-
-                // drain queue
-                for (uint i = 0; i < txLen; i++)
-                {
-                    queue_remove_blocking(&txFifo, &toSend[i]);
-                }
+            // running on RS485, handle a message from master if one was received,
+            // RS485 parses the bytes received so far and never waits, hence no timeout
+            xs.sync(0);
 
-                // write char to bus, this will clear the interrupt
-                uart_write_blocking(uart0, toSend, txLen);
-            }
-
-            if (queue_is_full(&txFifo) || queue_is_full(&rxFifo))
+            // replies go out by DMA in the background, nothing to drain here
+            if (txRing.overflow() || rxRing.overrun())
             {
-                // rx fifo is full, set the cpu_overload error flag
+                // reply did not fit the tx ring or rx ring was overrun, set the uart_overload error flag
                 _reg.errorSet(ERROR_MASK_UART_OVERLOAD);
             }
 
@@ -221,6 +208,7 @@ void core1Entry()
     uint64_t endOfCycle = 0;
     uint64_t cycleDuration = 0;
     int64_t sleepFor = 0;
+    uint64_t refreshDuration = 0;
 
     // let core0 lockout core1
     multicore_lockout_victim_init();
@@ -276,6 +264,21 @@ void core1Entry()
         // calculate remaining sleep time
         sleepFor = *_reg.desiredCycleTimeUs - cycleDuration;
 
+        // publish lazy statistics in idle time if it fits, does not count into the cycle time
+        if (sleepFor > static_cast<int64_t>(refreshDuration))
+        {
+            auto startOfRefresh = time_us_64();
+            auto published = device.refreshStatistics();
+            auto duration = time_us_64() - startOfRefresh;
+            sleepFor -= duration;
+
+            // only a refresh which published anything tells how long publishing takes
+            if (published)
+            {
+                refreshDuration = duration;
+            }
+        }
+
         // sleep for the remaining time
         if (sleepFor > 0)
         {
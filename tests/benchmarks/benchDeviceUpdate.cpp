@@ -0,0 +1,262 @@
+#include <benchmark/benchmark.h>
+
+#include "HostHal.hpp"
+#include "Devices/Scl3x00Model.hpp"
+#include "Devices/AbpModel.hpp"
+#include "Devices/Ads1115Model.hpp"
+#include "Devices/Hx711Model.hpp"
+#include "Hardware/Board/xerxes_rp2040.h"
+#include "Core/Register.hpp"
+#include "Core/Definitions.h"
+#include "Sensors/all.hpp"
+
+using namespace Xerxes;
+using namespace Xerxes::Sim;
+
+
+namespace
+{
+
+
+/**
+ * @brief Measure Device::update() on the simulated HAL
+ *
+ * Time is virtual, so the cost of bus transfers and sleeps inside the driver
+ * is not part of the result - only the CPU work of the firmware and of the
+ * simulation. The hardware has to be wired by the caller before, state.range(0)
+ * selects the calcStat config bit, state.range(1) lazy statistics,
+ * state.range(2) exponentially weighted statistics and state.range(3) the
+ * windows, histograms and Allan deviation.
+ */
+template <class Device>
+void measureUpdate(benchmark::State &state)
+{
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    *reg.gainPv0 = 1;
+    *reg.gainPv1 = 1;
+    *reg.gainPv2 = 1;
+    *reg.gainPv3 = 1;
+    *reg.desiredCycleTimeUs = DEFAULT_CYCLE_TIME_US;
+    reg.config->bits.freeRun = 1;
+    reg.config->bits.calcStat = state.range(0);
+    if(state.range(1))
+    {
+        reg.config->all |= MASK_CONFIG_LAZY_STATS;
+    }
+    if(state.range(2))
+    {
+        reg.config->all |= MASK_CONFIG_EW_STATS;
+        *reg.ewTimeConstantMs = 60'000;
+    }
+    if(state.range(3))
+    {
+        reg.config->all |= MASK_CONFIG_WINDOWS | MASK_CONFIG_HISTOGRAMS | MASK_CONFIG_ALLAN;
+    }
+
+    Device device(&reg);
+    device.init();
+
+    // fill the statistic buffers so every iteration works on a full window
+    for(int i = 0; i < RING_BUFFER_LEN; i++)
+    {
+        device.update();
+    }
+
+    for(auto _ : state)
+    {
+        device.update();
+        benchmark::ClobberMemory();
+    }
+
+    device.stop();
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/// @brief Power on state of the simulation in virtual time
+void resetSim()
+{
+    reset();
+    setTimeMode(TimeMode::VIRTUAL);
+}
+
+
+void BM_updateSCL3300(benchmark::State &state)
+{
+    resetSim();
+    auto inclinometer = Scl3x00Model::scl3300();
+    inclinometer.setAngle(0, sine(0.5, 0.1, 10) + noise(0.01, 0, 1));
+    inclinometer.setAngle(1, constant(5) + noise(0.01, 0, 2));
+    inclinometer.setAngle(2, constant(80));
+    inclinometer.setTemperature(constant(25));
+    attachSpiDevice(spi0, SPI0_CSN_PIN, &inclinometer);
+
+    measureUpdate<SCL3300>(state);
+    resetSim();
+}
+
+
+void BM_updateSCL3300a(benchmark::State &state)
+{
+    resetSim();
+    auto inclinometer = Scl3x00Model::scl3300();
+    inclinometer.setAngle(0, sine(0.5, 0.1, 10) + noise(0.01, 0, 1));
+    inclinometer.setAngle(1, constant(5) + noise(0.01, 0, 2));
+    inclinometer.setAngle(2, constant(80));
+    inclinometer.setTemperature(constant(25));
+    attachSpiDevice(spi0, SPI0_CSN_PIN, &inclinometer);
+
+    measureUpdate<SCL3300a>(state);
+    resetSim();
+}
+
+
+void BM_updateSCL3400(benchmark::State &state)
+{
+    resetSim();
+    auto inclinometer = Scl3x00Model::scl3400();
+    inclinometer.setAngle(0, sine(0.5, 0.1, 10) + noise(0.01, 0, 1));
+    inclinometer.setAngle(1, constant(5) + noise(0.01, 0, 2));
+    inclinometer.setTemperature(constant(25));
+    attachSpiDevice(spi0, SPI0_CSN_PIN, &inclinometer);
+
+    measureUpdate<SCL3400>(state);
+    resetSim();
+}
+
+
+void BM_updateABP(benchmark::State &state)
+{
+    resetSim();
+    AbpModel pressureSensor(0, 6000);
+    pressureSensor.setPressure(sine(50, 0.2, 1000) + noise(2));
+    pressureSensor.setTemperature(constant(25));
+    attachSpiDevice(spi0, SPI0_CSN_PIN, &pressureSensor);
+
+    measureUpdate<ABP>(state);
+    resetSim();
+}
+
+
+void BM_updateAnalogInput(benchmark::State &state)
+{
+    resetSim();
+    setAdcSignal(0, sine(1, 1, 1.5) + noise(0.005, 0, 1));
+    setAdcSignal(1, sine(0.2, 50, 1.5) + noise(0.005, 0, 2));
+    setAdcSignal(2, constant(1.0) + noise(0.005, 0, 3));
+    setAdcSignal(3, ramp(0.01, 0.5));
+
+    measureUpdate<AnalogInput>(state);
+    resetSim();
+}
+
+
+void BM_updateDiscreteAnalog(benchmark::State &state)
+{
+    resetSim();
+    Ads1115Model adc;
+    adc.setInput(0, sine(0.5, 0.5, 1.25) + noise(0.001, 0, 1));
+    adc.setInput(1, constant(1.0) + noise(0.001, 0, 2));
+    adc.setInput(2, ramp(0.001, 0.1));
+    adc.setInput(3, constant(2.5));
+    attachI2cDevice(i2c0, 0x48, &adc);
+
+    measureUpdate<DiscreteAnalog>(state);
+    resetSim();
+}
+
+
+void BM_updateHX711(benchmark::State &state)
+{
+    resetSim();
+    Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(sine(20000, 0.2, 100000) + noise(50));
+    attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    measureUpdate<HX711>(state);
+    resetSim();
+}
+
+
+void BM_update4DI4DO(benchmark::State &state)
+{
+    resetSim();
+    setGpioSignal(DI0_PIN, square(0, 1, 1));
+    setGpioSignal(DI1_PIN, square(0, 1, 2));
+    setGpioSignal(DI2_PIN, constant(1));
+    setGpioSignal(DI3_PIN, constant(0));
+
+    measureUpdate<_4DI4DO>(state);
+    resetSim();
+}
+
+
+void BM_updateEncoder(benchmark::State &state)
+{
+    resetSim();
+    Signal position = ramp(200);
+    setGpioSignal(DI0_PIN, quadrature(position, 0));
+    setGpioSignal(DI1_PIN, quadrature(position, 1));
+    setGpioSignal(DI2_PIN, constant(0));
+
+    measureUpdate<Encoder>(state);
+    resetSim();
+}
+
+
+void BM_updateCutter(benchmark::State &state)
+{
+    resetSim();
+    Signal position = ramp(200);
+    setGpioSignal(DI0_PIN, quadrature(position, 0));
+    setGpioSignal(DI1_PIN, quadrature(position, 1));
+    setGpioSignal(DI2_PIN, constant(0));
+
+    measureUpdate<Cutter>(state);
+    resetSim();
+}
+
+
+void BM_updateDS18B20(benchmark::State &state)
+{
+    // 1-Wire is not modelled, measures the disconnected sensor path
+    resetSim();
+    measureUpdate<DS18B20>(state);
+    resetSim();
+}
+
+
+void BM_updateLightSound(benchmark::State &state)
+{
+    resetSim();
+    setAdcSignal(0, sine(0.5, 100, 1.5) + noise(0.01, 0, 1));
+    setAdcSignal(2, constant(1.0));
+    setAdcSignal(3, constant(2.0));
+
+    measureUpdate<LightSound>(state);
+    resetSim();
+}
+
+
+} // namespace
+
+
+// arguments are the calcStat, lazy, exponentially weighted and optional statistics config bits
+#define DEVICE_UPDATE_BENCHMARK(fn) \
+    BENCHMARK(fn)->ArgNames({"calcStat", "lazyStat", "ewStat", "optStat"}) \
+        ->Args({0, 0, 0, 0})->Args({1, 0, 0, 0})->Args({1, 1, 0, 0})->Args({1, 0, 1, 0})->Args({1, 0, 0, 1})
+
+DEVICE_UPDATE_BENCHMARK(BM_updateSCL3300);
+DEVICE_UPDATE_BENCHMARK(BM_updateSCL3300a);
+DEVICE_UPDATE_BENCHMARK(BM_updateSCL3400);
+DEVICE_UPDATE_BENCHMARK(BM_updateABP);
+DEVICE_UPDATE_BENCHMARK(BM_updateAnalogInput);
+DEVICE_UPDATE_BENCHMARK(BM_updateDiscreteAnalog);
+DEVICE_UPDATE_BENCHMARK(BM_updateHX711);
+DEVICE_UPDATE_BENCHMARK(BM_update4DI4DO);
+DEVICE_UPDATE_BENCHMARK(BM_updateEncoder);
+DEVICE_UPDATE_BENCHMARK(BM_updateCutter);
+DEVICE_UPDATE_BENCHMARK(BM_updateDS18B20);
+DEVICE_UPDATE_BENCHMARK(BM_updateLightSound);
@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "HostHal.hpp"
+#include "Core/Definitions.h"
+#include "Core/DispatchTable.hpp"
+#include "Core/Slave.hpp"
+#include "Communication/RS485.hpp"
+
+using namespace Xerxes;
+
+
+namespace
+{
+
+
+constexpr uint8_t ADDRESS = 0xBA;
+constexpr uint8_t MASTER = 0x1E;
+
+uint32_t handled = 0;
+
+void handler(const Message &msg)
+{
+    benchmark::DoNotOptimize(msg.msgId);
+    handled++;
+}
+
+
+/// @brief Same ids and filters as the firmware, in the order main.cpp lists them
+constexpr auto routes = makeDispatchTable({
+    {MSGID_PING, Target::UNICAST, handler},
+    {MSGID_WRITE, Target::UNICAST, handler},
+    {MSGID_READ, Target::UNICAST, handler},
+    {MSGID_SYNC, Target::BROADCAST, handler},
+    {MSGID_SLEEP, Target::BROADCAST, handler},
+    {MSGID_RESET_SOFT, Target::BROADCAST, handler},
+    {MSGID_RESET_HARD, Target::UNICAST, handler},
+    {MSGID_GET_INFO, Target::UNICAST, handler},
+});
+
+
+/**
+ * @brief Dispatch as Slave did before the table, for reference
+ *
+ * std::function per message id in a hash map, each wrapping a lambda which
+ * filters the address like unicast() and broadcast() of the former BindWrapper.hpp.
+ */
+class MapDispatch
+{
+private:
+    std::unordered_map<msgid_t, std::function<void(const Message &)>> bindings;
+
+public:
+    explicit MapDispatch(const uint8_t *addr)
+    {
+        for(const Route &route : routes)
+        {
+            auto f = route.handler;
+            if(route.target == Target::UNICAST)
+            {
+                bindings.emplace(route.msgId, std::function<void(const Message &)>([f, addr](const Message &msg) {
+                    if(msg.dstAddr != 0xff && *addr == msg.dstAddr) f(msg);
+                }));
+            }
+            else
+            {
+                bindings.emplace(route.msgId, std::function<void(const Message &)>([f, addr](const Message &msg) {
+                    if(msg.dstAddr == 0xff || *addr == msg.dstAddr) f(msg);
+                }));
+            }
+        }
+    }
+
+    void call(const Message &msg)
+    {
+        if(bindings.contains(msg.msgId))
+        {
+            bindings[msg.msgId](msg);
+        }
+    }
+};
+
+
+/// @brief Mix of messages the slave sees on a shared bus, generated up front
+std::vector<Message> traffic()
+{
+    std::vector<Message> out;
+    for(const Route &route : routes)
+    {
+        out.emplace_back(MASTER, ADDRESS, route.msgId);
+        out.emplace_back(MASTER, BROADCAST_ADDR, route.msgId);
+        out.emplace_back(MASTER, ADDRESS + 1, route.msgId);
+    }
+    return out;
+}
+
+
+/// @brief Message to handler call, the hash map of std::function as before
+void BM_dispatchMap(benchmark::State &state)
+{
+    const uint8_t address = ADDRESS;
+    MapDispatch slave(&address);
+    const auto messages = traffic();
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        slave.call(messages[i++ % messages.size()]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/// @brief Message to handler call, the compile time table
+void BM_dispatchTable(benchmark::State &state)
+{
+    const uint8_t address = ADDRESS;
+    Slave slave(nullptr, &address);
+    slave.route(routes);
+    const auto messages = traffic();
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(slave.call(messages[i++ % messages.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/**
+ * @brief Frame in the UART to handler call
+ *
+ * The frame goes through the simulated UART, the DMA RX ring, the RS485 parser
+ * and the protocol, state.range(0) selects the table (1) or the hash map (0).
+ * Only the dispatch differs between the two.
+ */
+void BM_frameToHandler(benchmark::State &state)
+{
+    Sim::reset();
+    Sim::setTimeMode(Sim::TimeMode::VIRTUAL);
+    handled = 0;
+
+    UartRxRing rx;
+    UartTxRing tx;
+    rx.start(uart0, DEFAULT_BAUDRATE);
+    RS485 network(&tx, &rx);
+    Protocol protocol(&network);
+
+    const uint8_t address = ADDRESS;
+    Slave slave(&protocol, &address);
+    slave.route(routes);
+    MapDispatch map(&address);
+
+    const std::vector<uint8_t> frame = Message(MASTER, ADDRESS, MSGID_READ).toPacket().getData();
+    const bool useTable = state.range(0);
+
+    for(auto _ : state)
+    {
+        Sim::receiveUart(0, frame.data(), frame.size());
+        if(useTable)
+        {
+            slave.sync(0);
+        }
+        else
+        {
+            Message msg;
+            if(protocol.readMessage(msg, 0))
+            {
+                map.call(msg);
+            }
+        }
+    }
+
+    if(handled == 0)
+    {
+        state.SkipWithError("no frame reached the handler");
+    }
+    rx.stop();
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+} // namespace
+
+
+BENCHMARK(BM_dispatchMap);
+BENCHMARK(BM_dispatchTable);
+BENCHMARK(BM_frameToHandler)->Arg(0)->Arg(1);
@@ -0,0 +1,241 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "StatisticBuffer.hpp"
+#include "MultiChannelStatistics.hpp"
+#include "HampelFilter.hpp"
+
+using namespace Xerxes;
+
+
+namespace
+{
+
+/// @brief Samples fed to the buffer, generated up front so the generator is not measured
+template <class T>
+std::vector<T> samples(size_t count)
+{
+    std::mt19937 gen(1);
+    std::normal_distribution<double> dist(1000, 10);
+    std::vector<T> out(count);
+    for(auto &s : out)
+    {
+        s = static_cast<T>(dist(gen));
+    }
+    return out;
+}
+
+
+constexpr size_t SAMPLE_COUNT = 4096;  // power of 2, index is masked
+
+
+/**
+ * @brief Insert one value into a full buffer of state.range(0) elements
+ *
+ * @tparam Sum - type of the running sums, int64_t for the fixed point path
+ */
+template <class T, class Sum = double>
+void BM_insertOne(benchmark::State &state)
+{
+    const uint32_t len = static_cast<uint32_t>(state.range(0));
+    const auto values = samples<T>(SAMPLE_COUNT);
+    StatisticBuffer<T, 0, Sum> buffer(len);
+    for(uint32_t i = 0; i < len; i++)
+    {
+        buffer.insertOne(values[i % SAMPLE_COUNT]);
+    }
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        buffer.insertOne(values[i++ & (SAMPLE_COUNT - 1)]);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/**
+ * @brief Insert a block of 64 values into a full buffer of state.range(0) elements
+ *
+ * @tparam many - one insertMany() call, otherwise insertOne() per value
+ */
+template <class T, bool many, class Sum = double>
+void BM_insertBlock(benchmark::State &state)
+{
+    constexpr size_t BLOCK = 64;
+    const uint32_t len = static_cast<uint32_t>(state.range(0));
+    const auto values = samples<T>(SAMPLE_COUNT);
+    StatisticBuffer<T, 0, Sum> buffer(len);
+    for(uint32_t i = 0; i < len; i++)
+    {
+        buffer.insertOne(values[i % SAMPLE_COUNT]);
+    }
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        const T* block = values.data() + (i & (SAMPLE_COUNT - 1));
+        if constexpr(many)
+        {
+            buffer.insertMany(block, BLOCK);
+        }
+        else
+        {
+            for(size_t j = 0; j < BLOCK; j++)
+            {
+                buffer.insertOne(block[j]);
+            }
+        }
+        benchmark::ClobberMemory();
+        i += BLOCK;
+    }
+
+    state.SetItemsProcessed(state.iterations() * BLOCK);
+}
+
+
+/**
+ * @brief Insert one value and refresh statistics, this is what Sensor::update() does per PV
+ * 
+ * @tparam streaming - running sums for mean and standard deviation, otherwise full rescan
+ * @tparam Sum - type of the running sums, int64_t for the fixed point path
+ */
+template <class T, bool streaming = true, class Sum = double>
+void BM_insertAndUpdate(benchmark::State &state)
+{
+    const uint32_t len = static_cast<uint32_t>(state.range(0));
+    const auto values = samples<T>(SAMPLE_COUNT);
+    StatisticBuffer<T, 0, Sum> buffer(len, streaming);
+    for(uint32_t i = 0; i < len; i++)
+    {
+        buffer.insertOne(values[i % SAMPLE_COUNT]);
+    }
+
+    float min, max, mean, stdDev;
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        buffer.insertOne(values[i++ & (SAMPLE_COUNT - 1)]);
+        buffer.updateStatistics();
+        buffer.getStatistics(&min, &max, &mean, &stdDev);
+        benchmark::DoNotOptimize(mean);
+        benchmark::DoNotOptimize(stdDev);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/// @brief Insert one sample of 4 process values into 4 buffers and publish, as drivers used to
+template <uint32_t N>
+void BM_fourBuffers(benchmark::State &state)
+{
+    const auto values = samples<float>(SAMPLE_COUNT);
+    std::array<StatisticBuffer<float, N>, 4> buffers;
+    float pv[4], min[4], max[4], mean[4], stdDev[4];
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        for(uint32_t ch = 0; ch < 4; ch++)
+        {
+            pv[ch] = values[(i + ch) & (SAMPLE_COUNT - 1)];
+            buffers[ch].insertOne(pv[ch]);
+        }
+        for(uint32_t ch = 0; ch < 4; ch++)
+        {
+            buffers[ch].updateStatistics();
+            buffers[ch].getStatistics(&min[ch], &max[ch], &mean[ch], &stdDev[ch]);
+        }
+        benchmark::DoNotOptimize(mean);
+        i += 4;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/// @brief Same as BM_fourBuffers with one MultiChannelStatistics, Order selects min/max and percentiles
+template <uint32_t N, uint8_t Order>
+void BM_multiChannel(benchmark::State &state)
+{
+    const auto values = samples<float>(SAMPLE_COUNT);
+    MultiChannelStatistics<4, float, N, double, Order> statistics;
+    float pv[4], min[4], max[4], mean[4], stdDev[4];
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        for(uint32_t ch = 0; ch < 4; ch++)
+        {
+            pv[ch] = values[(i + ch) & (SAMPLE_COUNT - 1)];
+        }
+        statistics.insert(pv);
+        statistics.updateStatistics();
+        statistics.getStatistics(min, max, mean, stdDev);
+        benchmark::DoNotOptimize(mean);
+        i += 4;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+/// @brief Outlier rejection of one sample of 4 process values, median window of K samples
+template <uint32_t K>
+void BM_hampelFilter(benchmark::State &state)
+{
+    const auto values = samples<float>(SAMPLE_COUNT);
+    HampelFilter<4, float, K> filter;
+
+    size_t i = 0;
+    for(auto _ : state)
+    {
+        std::array<float, 4> sample;
+        std::copy_n(values.data() + (i & (SAMPLE_COUNT - 1)), 4, sample.begin());
+        benchmark::DoNotOptimize(filter.filter(sample.data()));
+        i += 4;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+} // namespace
+
+
+// RING_BUFFER_LEN from 10 to 10k
+#define STATISTIC_BUFFER_BENCHMARK(fn, ...) \
+    BENCHMARK_TEMPLATE(fn, __VA_ARGS__)->RangeMultiplier(10)->Range(10, 10000)
+
+STATISTIC_BUFFER_BENCHMARK(BM_insertOne, float);
+STATISTIC_BUFFER_BENCHMARK(BM_insertOne, int);
+STATISTIC_BUFFER_BENCHMARK(BM_insertOne, double);
+STATISTIC_BUFFER_BENCHMARK(BM_insertOne, int32_t, int64_t);
+
+STATISTIC_BUFFER_BENCHMARK(BM_insertBlock, int32_t, false, int64_t);
+STATISTIC_BUFFER_BENCHMARK(BM_insertBlock, int32_t, true, int64_t);
+
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, float);
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, int);
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, double);
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, int32_t, true, int64_t);
+
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, float, false);
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, int, false);
+STATISTIC_BUFFER_BENCHMARK(BM_insertAndUpdate, double, false);
+
+BENCHMARK_TEMPLATE(BM_fourBuffers, 100);
+BENCHMARK_TEMPLATE(BM_multiChannel, 100, ORDER_ALL);
+BENCHMARK_TEMPLATE(BM_multiChannel, 100, ORDER_NONE);
+BENCHMARK_TEMPLATE(BM_fourBuffers, 1000);
+BENCHMARK_TEMPLATE(BM_multiChannel, 1000, ORDER_ALL);
+BENCHMARK_TEMPLATE(BM_multiChannel, 1000, ORDER_NONE);
+
+BENCHMARK_TEMPLATE(BM_hampelFilter, 7);
+BENCHMARK_TEMPLATE(BM_hampelFilter, 15);
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Benchmark entry point, same as BENCHMARK_MAIN() but reports in JSON by default
+ *
+ * JSON is what the regression tracking consumes, pass --benchmark_format=console
+ * (or any other format) to override. Files written with --benchmark_out are JSON
+ * unless --benchmark_out_format says otherwise.
+ */
+int main(int argc, char **argv)
+{
+    std::vector<char *> args(argv, argv + argc);
+
+    bool formatGiven = false;
+    bool outFormatGiven = false;
+    for(int i = 1; i < argc; i++)
+    {
+        formatGiven |= std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+        outFormatGiven |= std::strncmp(argv[i], "--benchmark_out_format", 22) == 0;
+    }
+
+    static char jsonFormat[] = "--benchmark_format=json";
+    static char jsonOutFormat[] = "--benchmark_out_format=json";
+    if(!formatGiven) args.push_back(jsonFormat);
+    if(!outFormatGiven) args.push_back(jsonOutFormat);
+
+    int newArgc = static_cast<int>(args.size());
+    benchmark::Initialize(&newArgc, args.data());
+    if(benchmark::ReportUnrecognizedArguments(newArgc, args.data()))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "Communication/Callbacks.hpp"
+#include "Communication/RS485.hpp"
+#include "Core/Definitions.h"
+#include "Core/Register.hpp"
+#include "Core/Slave.hpp"
+#include "Hardware/InitUtils.hpp"
+#include "Sensors/Generic/hx711.hpp"
+#include "MessageId.h"
+#include "Protocol.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Xerxes;
+
+
+namespace
+{
+
+/// @brief Network which keeps the replies of the callbacks instead of sending them
+class RecordingNetwork : public Network
+{
+public:
+    mutable std::vector<Packet> sent;
+
+    bool sendData(const Packet &toSend) const override
+    {
+        sent.push_back(toSend);
+        return true;
+    }
+
+    bool readData(const uint64_t, Packet &) override { return false; }
+};
+
+RecordingNetwork network;
+Protocol protocol(&network);
+uint8_t address = 0x10;
+
+} // namespace
+
+
+// globals the callbacks are bound to, as main.cpp defines them for the firmware
+Register _reg;
+Slave xs(&protocol, &address);
+HX711 device(&_reg);
+
+// factory reset of the board init, not under test
+void userLoadDefaultValues() {}
+
+
+namespace
+{
+
+/// @brief Request MSGID_READ_MULTI of the ranges and return the only reply
+Message readMulti(const std::vector<std::pair<uint16_t, uint8_t>> &ranges)
+{
+    std::vector<uint8_t> payload;
+    for(const auto &[offset, len] : ranges)
+    {
+        payload.insert(payload.end(), {static_cast<uint8_t>(offset), static_cast<uint8_t>(offset >> 8), len});
+    }
+
+    network.sent.clear();
+    readMultiCallback(Message(0x1E, address, MSGID_READ_MULTI, payload));
+    EXPECT_EQ(network.sent.size(), 1);
+    return Message(network.sent.back());
+}
+
+std::vector<uint8_t> payloadOf(const Message &reply)
+{
+    return std::vector<uint8_t>(reply.payloadBegin(), reply.end());
+}
+
+void fillRegister()
+{
+    for(size_t i = 0; i < EXTENDED_REGISTER_SIZE; i++)
+    {
+        _reg.memTable[i] = static_cast<uint8_t>(i * 7);
+    }
+}
+
+} // namespace
+
+
+TEST(Callbacks, readMultiConcatenatesRanges)
+{
+    fillRegister();
+
+    // out of order and up to the end of the extended register
+    const Message reply = readMulti({{300, 2}, {10, 4}, {EXTENDED_REGISTER_SIZE - 3, 3}});
+    EXPECT_EQ(reply.msgId, MSGID_READ_VALUE);
+    EXPECT_EQ(reply.dstAddr, 0x1E);
+
+    std::vector<uint8_t> expected;
+    expected.insert(expected.end(), _reg.memTable + 300, _reg.memTable + 302);
+    expected.insert(expected.end(), _reg.memTable + 10, _reg.memTable + 14);
+    expected.insert(expected.end(), _reg.memTable + EXTENDED_REGISTER_SIZE - 3, _reg.memTable + EXTENDED_REGISTER_SIZE);
+    EXPECT_EQ(payloadOf(reply), expected);
+
+    // ranges of the statistics are read too
+    const Message stats = readMulti({{MEAN_PV0_OFFSET, 4}, {PV0_OFFSET, 4}});
+    EXPECT_EQ(stats.msgId, MSGID_READ_VALUE);
+    EXPECT_EQ(payloadOf(stats).size(), 8);
+}
+
+
+TEST(Callbacks, readMultiRejectsRangeBeyondRegister)
+{
+    fillRegister();
+
+    // first range is valid, nothing is sent for it
+    const Message reply = readMulti({{10, 4}, {EXTENDED_REGISTER_SIZE - 1, 2}});
+    EXPECT_EQ(reply.msgId, MSGID_ACK_NOK);
+    EXPECT_TRUE(payloadOf(reply).empty());
+}
+
+
+TEST(Callbacks, readMultiRejectsMalformedLength)
+{
+    // no range at all
+    EXPECT_EQ(readMulti({}).msgId, MSGID_ACK_NOK);
+
+    // a range cut short after its offset
+    network.sent.clear();
+    readMultiCallback(Message(0x1E, address, MSGID_READ_MULTI, {10, 0, 4, 20}));
+    ASSERT_EQ(network.sent.size(), 1);
+    EXPECT_EQ(Message(network.sent.back()).msgId, MSGID_ACK_NOK);
+}
+
+
+TEST(Callbacks, readMultiRejectsReplyLargerThanFrame)
+{
+    fillRegister();
+
+    // src, dst and msgid take 4 bytes of the frame body
+    constexpr uint8_t maxReply = RS485::MAX_BODY - 4;
+
+    const Message full = readMulti({{0, 200}, {200, maxReply - 200}});
+    EXPECT_EQ(full.msgId, MSGID_READ_VALUE);
+    EXPECT_EQ(payloadOf(full), std::vector<uint8_t>(_reg.memTable, _reg.memTable + maxReply));
+
+    const Message tooLarge = readMulti({{0, 200}, {200, maxReply - 199}});
+    EXPECT_EQ(tooLarge.msgId, MSGID_ACK_NOK);
+}
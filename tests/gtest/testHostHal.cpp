@@ -0,0 +1,633 @@
+#include <gtest/gtest.h>
+
+#include "HostHal.hpp"
+#include "Devices/Scl3x00Model.hpp"
+#include "Devices/Hx711Model.hpp"
+#include "Devices/Ads1115Model.hpp"
+#include "hardware/adc.h"
+#include "hardware/flash.h"
+#include "hardware/gpio.h"
+#include "pico/time.h"
+#include "pico/util/queue.h"
+#include "Hardware/Board/xerxes_rp2040.h"
+#include "Core/Register.hpp"
+#include "Sensors/Generic/hx711.hpp"
+#include "Sensors/Generic/DiscreteAnalog.hpp"
+#include "Communication/RS485.hpp"
+#include "Communication/UartRxRing.hpp"
+#include "Communication/UartTxRing.hpp"
+#include "hardware/uart.h"
+
+using namespace Xerxes;
+
+
+class HostHal : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Sim::reset();
+        Sim::setTimeMode(Sim::TimeMode::VIRTUAL);
+    }
+
+    void TearDown() override
+    {
+        Sim::setTimeMode(Sim::TimeMode::REAL);
+        Sim::reset();
+    }
+};
+
+
+TEST_F(HostHal, queueKeepsOrderAndCapacity)
+{
+    queue_t q;
+    queue_init(&q, 1, 4);
+
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(queue_try_add(&q, &i));
+    }
+    uint8_t overflow = 0xAA;
+    EXPECT_FALSE(queue_try_add(&q, &overflow));
+    EXPECT_TRUE(queue_is_full(&q));
+
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        uint8_t el;
+        EXPECT_TRUE(queue_try_remove(&q, &el));
+        EXPECT_EQ(el, i);
+    }
+    EXPECT_TRUE(queue_is_empty(&q));
+    queue_free(&q);
+}
+
+
+TEST_F(HostHal, virtualTimeAdvancesOnSleep)
+{
+    EXPECT_EQ(time_us_64(), 0);
+    sleep_ms(5);
+    sleep_us(10);
+    EXPECT_EQ(time_us_64(), 5010);
+
+    auto timeout = make_timeout_time_us(100);
+    EXPECT_FALSE(time_reached(timeout));
+    Sim::advanceTime(100);
+    EXPECT_TRUE(time_reached(timeout));
+}
+
+
+TEST_F(HostHal, adcFollowsSignal)
+{
+    Sim::setAdcSignal(1, Sim::constant(1.65));
+    adc_select_input(1);
+    EXPECT_EQ(adc_read(), 2048);
+
+    Sim::setAdcSignal(1, Sim::constant(5));
+    EXPECT_EQ(adc_read(), 4095);
+}
+
+
+TEST_F(HostHal, flashProgramOnlyClearsBits)
+{
+    constexpr uint32_t offset = PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE;
+    const uint8_t *xip = reinterpret_cast<const uint8_t *>(XIP_BASE + offset);
+
+    uint8_t page[FLASH_PAGE_SIZE];
+    std::fill(std::begin(page), std::end(page), 0x0F);
+    flash_range_program(offset, page, sizeof(page));
+    std::fill(std::begin(page), std::end(page), 0xF3);
+    flash_range_program(offset, page, sizeof(page));
+    EXPECT_EQ(xip[0], 0x03);
+
+    flash_range_erase(offset, FLASH_SECTOR_SIZE);
+    EXPECT_EQ(xip[FLASH_PAGE_SIZE - 1], 0xFF);
+}
+
+
+TEST_F(HostHal, scl3300RepliesOffFrame)
+{
+    auto sensor = Sim::Scl3x00Model::scl3300();
+    sensor.setAngle(0, Sim::constant(45));
+    Sim::attachSpiDevice(spi0, SPI0_CSN_PIN, &sensor);
+
+    gpio_init(SPI0_CSN_PIN);
+    gpio_set_dir(SPI0_CSN_PIN, GPIO_OUT);
+    gpio_put(SPI0_CSN_PIN, 1);
+
+    auto exchange = [](uint32_t command)
+    {
+        uint32_t tx = __builtin_bswap32(command), rx;
+        gpio_put(SPI0_CSN_PIN, 0);
+        spi_write_read_blocking(spi0, (uint8_t *)&tx, (uint8_t *)&rx, 4);
+        gpio_put(SPI0_CSN_PIN, 1);
+        return __builtin_bswap32(rx);
+    };
+
+    exchange(0x240000C7);  // Read_ANG_X
+    uint32_t reply = exchange(0x40000091);  // Read_WHOAMI, returns ANG_X
+    EXPECT_EQ((reply >> 26) & 0x1F, 0x09);
+    EXPECT_EQ(static_cast<int16_t>(reply >> 8), 8192);  // 45° = 2^15 / 4
+
+    reply = exchange(0x40000091);
+    EXPECT_EQ((reply >> 8) & 0xFFFF, 0xC1);
+
+    Sim::attachSpiDevice(spi0, SPI0_CSN_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, hx711ShiftsOutTwosComplement)
+{
+    Sim::Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(Sim::constant(-12345));
+    Sim::attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    gpio_init(I2C0_SCL_PIN);
+    gpio_set_dir(I2C0_SCL_PIN, GPIO_OUT);
+    gpio_init(I2C0_SDA_PIN);
+    gpio_set_dir(I2C0_SDA_PIN, GPIO_IN);
+
+    EXPECT_FALSE(gpio_get(I2C0_SDA_PIN));  // conversion ready
+
+    int32_t count = 0;
+    for(int i = 0; i < 24; i++)
+    {
+        gpio_put(I2C0_SCL_PIN, 1);
+        gpio_put(I2C0_SCL_PIN, 0);
+        count = (count << 1) | gpio_get(I2C0_SDA_PIN);
+    }
+    gpio_put(I2C0_SCL_PIN, 1);
+    gpio_put(I2C0_SCL_PIN, 0);
+
+    // sign extend 24 bit value
+    count = (count ^ 0x800000) - (1 << 23);
+    EXPECT_EQ(count, -12345);
+
+    Sim::attachGpioDevice(I2C0_SCL_PIN, nullptr);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, lazyStatisticsArePublishedOnRefresh)
+{
+    Sim::Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(Sim::constant(-12345));
+    Sim::attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+    reg.config->all |= MASK_CONFIG_LAZY_STATS;
+
+    HX711 scale(&reg);
+    scale.init();
+    scale.update();
+    scale.update();
+
+    // samples are inserted, statistics wait for refresh
+    EXPECT_EQ(*reg.pv0, -12345);
+    EXPECT_EQ(*reg.meanPv0, 0);
+
+    scale.refreshStatistics();
+    EXPECT_EQ(*reg.meanPv0, -12345);
+    EXPECT_EQ(*reg.minPv0, -12345);
+    EXPECT_EQ(*reg.p50Pv0, -12345);
+
+    // without lazy statistics every update publishes
+    reg.config->all &= ~MASK_CONFIG_LAZY_STATS;
+    bridge.setInput(Sim::constant(12345));
+    scale.update();
+    EXPECT_EQ(*reg.maxPv0, 12345);
+
+    scale.stop();
+    Sim::attachGpioDevice(I2C0_SCL_PIN, nullptr);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, discreteAnalogKeepsRatiosInItsWindow)
+{
+    Sim::Ads1115Model adc;
+    adc.setInput(0, Sim::constant(1.0));
+    adc.setInput(1, Sim::constant(2.0));
+    adc.setInput(2, Sim::constant(0.5));
+    adc.setInput(3, Sim::constant(2.5));
+    Sim::attachI2cDevice(i2c0, 0x48, &adc);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+
+    DiscreteAnalog ai(&reg);
+    ai.init();
+    for(int i = 0; i < 5; i++)
+    {
+        ai.update();
+    }
+
+    // ratios to the reference on the scale of the process values, within the 16 bit ADC resolution
+    EXPECT_NEAR(*reg.meanPv0, 0.4, 1e-3);
+    EXPECT_NEAR(*reg.meanPv1, 0.8, 1e-3);
+    EXPECT_NEAR(*reg.maxPv2, 0.2, 1e-3);
+    EXPECT_NEAR(*reg.p50Pv3, 2.5, 1e-3);
+    EXPECT_NEAR(*reg.meanPv0, *reg.pv0, 1e-6);
+
+    Sim::attachI2cDevice(i2c0, 0x48, nullptr);
+}
+
+
+TEST_F(HostHal, discreteAnalogSkipsRatiosToZeroReference)
+{
+    Sim::Ads1115Model adc;
+    adc.setInput(0, Sim::constant(1.0));
+    adc.setInput(1, Sim::constant(0.0));
+    adc.setInput(2, Sim::constant(0.5));
+    adc.setInput(3, Sim::constant(2.5));
+    Sim::attachI2cDevice(i2c0, 0x48, &adc);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+
+    DiscreteAnalog ai(&reg);
+    ai.init();
+    for(int i = 0; i < 3; i++)
+    {
+        ai.update();
+    }
+
+    // inf and NaN ratios have no counts, the window keeps the cycles before
+    adc.setInput(3, Sim::constant(0.0));
+    for(int i = 0; i < 3; i++)
+    {
+        ai.update();
+    }
+    EXPECT_TRUE(std::isinf(*reg.pv0));
+    EXPECT_TRUE(std::isnan(*reg.pv1));
+    EXPECT_NEAR(*reg.meanPv0, 0.4, 1e-3);
+    EXPECT_NEAR(*reg.maxPv1, 0, 1e-3);
+    EXPECT_NEAR(*reg.meanPv3, 2.5, 1e-3);
+
+    // ratios beyond the fixed point range saturate instead of wrapping around
+    adc.setInput(3, Sim::constant(4.096 / 32768));
+    ai.update();
+    EXPECT_GT(*reg.pv0, 2048);
+    EXPECT_NEAR(*reg.maxPv0, 2048, 1e-3);
+    EXPECT_GT(*reg.meanPv0, 0.4);
+
+    Sim::attachI2cDevice(i2c0, 0x48, nullptr);
+}
+
+
+TEST_F(HostHal, optionalStatisticsFollowConfigBits)
+{
+    Sim::Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(Sim::constant(-12345));
+    Sim::attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+    *reg.histogramMin = -20000;
+    *reg.histogramWidth = 10000;
+
+    HX711 scale(&reg);
+    scale.init();
+
+    // histogram is off without its config bit
+    scale.update();
+    scale.update();
+    EXPECT_EQ(reg.histogram->bins[0][0], 0);
+
+    reg.config->all |= MASK_CONFIG_HISTOGRAMS;
+    scale.update();
+    scale.update();
+    EXPECT_EQ(reg.histogram->bins[0][0], 2);
+
+    // switched off the register is left alone, switched on again it restarts
+    reg.config->all &= ~MASK_CONFIG_HISTOGRAMS;
+    scale.update();
+    EXPECT_EQ(reg.histogram->bins[0][0], 2);
+    reg.config->all |= MASK_CONFIG_HISTOGRAMS;
+    scale.update();
+    EXPECT_EQ(reg.histogram->bins[0][0], 1);
+
+    scale.stop();
+    Sim::attachGpioDevice(I2C0_SCL_PIN, nullptr);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, exponentialStatisticsFollowTimeConstant)
+{
+    Sim::Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(Sim::constant(1000));
+    Sim::attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+    reg.config->all |= MASK_CONFIG_EW_STATS;
+    *reg.ewTimeConstantMs = 1000;
+
+    HX711 scale(&reg);
+    scale.init();
+    scale.update();
+    EXPECT_EQ(*reg.meanPv0, 1000);
+    EXPECT_EQ(*reg.stdDevPv0, 0);
+    EXPECT_TRUE(std::isnan(*reg.minPv0));
+    EXPECT_TRUE(std::isnan(*reg.p50Pv0));
+
+    // step response after one time constant is 1 - 1/e, regardless of the cycle time
+    for(uint32_t cycleTimeUs : {10'000u, 50'000u})
+    {
+        bridge.setInput(Sim::constant(1000));
+        scale.update();
+        bridge.setInput(Sim::constant(2000));
+        *reg.desiredCycleTimeUs = cycleTimeUs;
+        for(uint32_t t = 0; t < 1'000'000; t += cycleTimeUs)
+        {
+            scale.update();
+        }
+        EXPECT_NEAR(*reg.meanPv0, 2000 - 1000 * exp(-1), 1) << cycleTimeUs << " us";
+
+        // settle back
+        bridge.setInput(Sim::constant(1000));
+        *reg.ewTimeConstantMs = 0;
+        scale.update();
+        EXPECT_EQ(*reg.meanPv0, 1000);
+        *reg.ewTimeConstantMs = 1000;
+    }
+
+    scale.stop();
+    Sim::attachGpioDevice(I2C0_SCL_PIN, nullptr);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, outliersAreReplacedBeforeStatistics)
+{
+    Sim::Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    Sim::attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+    reg.config->all |= MASK_CONFIG_REJECT_OUTLIERS;
+
+    HX711 scale(&reg);
+    scale.init();
+
+    // single sample spikes between noisy samples, first spike comes after the median window is full
+    const Sim::Signal quiet = Sim::noise(20, 1000);
+    for(int i = 0; i < 60; i++)
+    {
+        bridge.setInput(i % 10 == 9 ? Sim::constant(500000) : quiet);
+        scale.update();
+    }
+
+    // all 6 spikes, MAD of 7 noisy samples is rough - a few noise samples may go as well
+    const uint32_t rejected = *reg.rejectedPv0;
+    EXPECT_GE(rejected, 6);
+    EXPECT_LE(rejected, 9);
+    EXPECT_EQ(*reg.pv0, 500000);    // process value is not filtered
+    EXPECT_LT(*reg.maxPv0, 1200);
+    EXPECT_LT(*reg.stdDevPv0, 50);
+
+    // without rejection the spikes reach the statistics
+    reg.config->all &= ~MASK_CONFIG_REJECT_OUTLIERS;
+    scale.update();
+    EXPECT_EQ(*reg.maxPv0, 500000);
+    EXPECT_EQ(*reg.rejectedPv0, rejected);
+
+    scale.stop();
+    Sim::attachGpioDevice(I2C0_SCL_PIN, nullptr);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, pvSnapshotPairsCycleWithItsStatistics)
+{
+    Sim::Hx711Model bridge(I2C0_SCL_PIN, I2C0_SDA_PIN);
+    bridge.setInput(Sim::constant(-12345));
+    Sim::attachGpioDevice(I2C0_SCL_PIN, &bridge);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, &bridge);
+
+    Register reg;
+    std::fill(std::begin(reg.memTable), std::end(reg.memTable), 0);
+    reg.config->bits.calcStat = 1;
+    reg.config->all |= MASK_CONFIG_LAZY_STATS;
+
+    HX711 scale(&reg);
+    scale.init();
+    scale.update();
+    const uint64_t sampled = time_us_64();
+    scale.update();
+    *reg.error = 0x42;
+
+    // layout the master unpacks with "<IIQQ12f"
+    static_assert(offsetof(PvSnapshot, timestampUs) == 8);
+    static_assert(offsetof(PvSnapshot, pv) == 24);
+    static_assert(offsetof(PvSnapshot, stdDev) == 56);
+
+    // lazy statistics are published for the snapshot
+    PvSnapshot snapshot;
+    ASSERT_TRUE(scale.snapshot(snapshot));
+    EXPECT_EQ(snapshot.version, PV_SNAPSHOT_VERSION);
+    EXPECT_GE(snapshot.timestampUs, sampled);
+    EXPECT_LE(snapshot.timestampUs, time_us_64());
+    EXPECT_EQ(snapshot.netCycleTimeUs, *reg.netCycleTimeUs);
+    EXPECT_EQ(snapshot.error, 0x42);
+    EXPECT_EQ(snapshot.pv[0], -12345);
+    EXPECT_EQ(snapshot.mean[0], -12345);
+    EXPECT_EQ(snapshot.stdDev[0], 0);
+    EXPECT_EQ(*reg.meanPv0, -12345);
+
+    // next cycle has written its process value but not yet inserted it
+    *reg.pv0 = 1;
+    ASSERT_TRUE(scale.snapshot(snapshot));
+    EXPECT_EQ(snapshot.pv[0], -12345);
+    EXPECT_EQ(snapshot.mean[0], -12345);
+
+    scale.stop();
+    Sim::attachGpioDevice(I2C0_SCL_PIN, nullptr);
+    Sim::attachGpioDevice(I2C0_SDA_PIN, nullptr);
+}
+
+
+TEST_F(HostHal, uartRxRingFeedsRs485)
+{
+    // short DMA transfers, the completion IRQ restarts them many times
+    UartRxRing ring(16);
+    ring.start(uart0, DEFAULT_BAUDRATE);
+    UartTxRing tx;
+    RS485 network(&tx, &ring);
+
+    // more bytes than the ring holds, the write address wraps
+    for(uint8_t i = 0; i < 100; i++)
+    {
+        const std::vector<uint8_t> body {0x1E, 0xBA, i, 0, 1, 2, 3, 4, 5, 6};
+        const std::vector<uint8_t> wire = Packet(body).getData();
+        Sim::receiveUart(0, wire.data(), wire.size());
+
+        Packet received;
+        ASSERT_TRUE(network.readData(1000, received)) << "packet " << int(i);
+        EXPECT_EQ(received.getData(), wire) << "packet " << int(i);
+    }
+    EXPECT_FALSE(ring.overrun());
+
+    // nobody reads, DMA laps the reader and the unread bytes are dropped
+    const std::vector<uint8_t> flood(UartRxRing::SIZE + 10, 0x55);
+    Sim::receiveUart(0, flood.data(), flood.size());
+    EXPECT_EQ(ring.available(), 0);
+    EXPECT_TRUE(ring.overrun());
+    EXPECT_FALSE(ring.overrun());
+
+    const std::vector<uint8_t> wire = Packet(std::vector<uint8_t> {1, 2, 3}).getData();
+    Sim::receiveUart(0, wire.data(), wire.size());
+    Packet received;
+    EXPECT_TRUE(network.readData(1000, received));
+    EXPECT_EQ(received.getData(), wire);
+
+    // DMA laps the reader between two bytes of one poll, the stale byte is not returned
+    const std::vector<uint8_t> head {1, 2};
+    Sim::receiveUart(0, head.data(), head.size());
+    uint8_t byte;
+    ASSERT_TRUE(ring.tryGet(byte));
+    EXPECT_EQ(byte, 1);
+    Sim::receiveUart(0, flood.data(), flood.size());
+    EXPECT_FALSE(ring.tryGet(byte));
+    EXPECT_TRUE(ring.overrun());
+    EXPECT_EQ(ring.available(), 0);
+
+    ring.stop();
+}
+
+
+TEST_F(HostHal, cutOffPacketEndsOnIdleLine)
+{
+    Sim::setTimeMode(Sim::TimeMode::REAL);
+
+    UartRxRing ring;
+    ring.start(uart0, DEFAULT_BAUDRATE);
+    UartTxRing tx;
+    RS485 network(&tx, &ring);
+
+    // SOH, length of 10 and 3 bytes of the body, the rest never comes
+    const uint8_t cutOff[] = {SOH, 10, 0x1E, 0xBA, 0};
+    Sim::receiveUart(0, cutOff, sizeof(cutOff));
+
+    // parser does not wait for the rest, the partial frame is kept
+    Packet received;
+    const uint64_t start = time_us_64();
+    EXPECT_FALSE(network.readData(500'000, received));
+    EXPECT_LT(time_us_64() - start, UART_RX_IDLE_MIN_US);
+    EXPECT_EQ(network.parserState(), RS485::ParserState::BODY);
+
+    // line goes idle, the partial frame is dropped
+    while(network.parserState() != RS485::ParserState::WAIT_SOH)
+    {
+        EXPECT_FALSE(network.readData(0, received));
+        ASSERT_LT(time_us_64() - start, 100'000);
+    }
+    EXPECT_GE(time_us_64() - start, UART_RX_IDLE_MIN_US);
+
+    // next packet is received as a whole
+    const std::vector<uint8_t> wire = Packet(std::vector<uint8_t> {1, 2, 3}).getData();
+    Sim::receiveUart(0, wire.data(), wire.size());
+    EXPECT_TRUE(network.readData(0, received));
+    EXPECT_EQ(received.getData(), wire);
+
+    ring.stop();
+}
+
+
+TEST_F(HostHal, rs485ParserResumesAcrossCalls)
+{
+    UartRxRing ring;
+    ring.start(uart0, DEFAULT_BAUDRATE);
+    UartTxRing tx;
+    RS485 network(&tx, &ring);
+
+    const std::vector<uint8_t> first = Packet(std::vector<uint8_t> {0x1E, 0xBA, 7, 0, 9, 8}).getData();
+    const std::vector<uint8_t> second = Packet(std::vector<uint8_t> {0x1E, 0xBA, 8, 0}).getData();
+
+    // noise before the frame, then the frame byte by byte, every call returns at once
+    const uint8_t noise[] = {0x55, SOH, 2, 0xAA};
+    Sim::receiveUart(0, noise, sizeof(noise));
+    Packet received;
+    for(size_t i = 0; i + 1 < first.size(); i++)
+    {
+        Sim::receiveUart(0, &first[i], 1);
+        EXPECT_FALSE(network.readData(0, received)) << "byte " << i;
+    }
+    EXPECT_EQ(network.parserState(), RS485::ParserState::CHECKSUM);
+    Sim::receiveUart(0, &first.back(), 1);
+    ASSERT_TRUE(network.readData(0, received));
+    EXPECT_EQ(received.getData(), first);
+
+    // frame with a bad checksum is dropped, the one behind it is not
+    std::vector<uint8_t> corrupted = first;
+    corrupted.back() ^= 0xFF;
+    Sim::receiveUart(0, corrupted.data(), corrupted.size());
+    Sim::receiveUart(0, second.data(), second.size());
+    ASSERT_TRUE(network.readData(0, received));
+    EXPECT_EQ(received.getData(), second);
+
+    // two frames at once, one per call
+    Sim::receiveUart(0, first.data(), first.size());
+    Sim::receiveUart(0, second.data(), second.size());
+    ASSERT_TRUE(network.readData(0, received));
+    EXPECT_EQ(received.getData(), first);
+    ASSERT_TRUE(network.readData(0, received));
+    EXPECT_EQ(received.getData(), second);
+    EXPECT_FALSE(network.readData(0, received));
+    EXPECT_EQ(network.parserState(), RS485::ParserState::WAIT_SOH);
+
+    ring.stop();
+}
+
+
+TEST_F(HostHal, uartTxRingSendsInBackground)
+{
+    std::vector<uint8_t> line;
+    Sim::setUartListener(0, [&line](uint8_t byte) { line.push_back(byte); });
+
+    UartRxRing rx;
+    UartTxRing tx;
+    rx.start(uart0, DEFAULT_BAUDRATE);
+    tx.start(uart0);
+    RS485 network(&tx, &rx);
+
+    // more bytes than the ring holds, frames wrap around its end
+    std::vector<uint8_t> expected;
+    for(uint8_t i = 0; i < 200; i++)
+    {
+        const std::vector<uint8_t> body {0x1E, 0xBA, i, 0, 1, 2, 3, 4, 5, 6};
+        const Packet packet(body);
+        ASSERT_TRUE(network.sendData(packet)) << "packet " << int(i);
+        const std::vector<uint8_t> wire = packet.getData();
+        expected.insert(expected.end(), wire.begin(), wire.end());
+    }
+    EXPECT_GT(expected.size(), UartTxRing::SIZE);
+    EXPECT_TRUE(tx.idle());
+    EXPECT_EQ(line, expected);
+    EXPECT_FALSE(tx.overflow());
+
+    // frame larger than the ring is rejected as a whole
+    const std::vector<uint8_t> huge(UartTxRing::SIZE + 1, 0x55);
+    line.clear();
+    EXPECT_FALSE(tx.send(huge.data(), huge.size()));
+    EXPECT_TRUE(line.empty());
+    EXPECT_TRUE(tx.overflow());
+    EXPECT_FALSE(tx.overflow());
+
+    tx.stop();
+    rx.stop();
+    EXPECT_FALSE(tx.send(huge.data(), 1));
+    Sim::setUartListener(0, nullptr);
+}
@@ -2,8 +2,10 @@
 
 #include "Message.hpp"
 #include "MessageId.h"
+#include "Core/DispatchTable.hpp"
 
 using namespace std;
+using Xerxes::SOH;
 
 
 TEST(Message, toPacket)
@@ -55,7 +57,7 @@ TEST(Message, MessageFromPacket)
 {
     Xerxes::Message pingMsg(0x1E, 0xBA, MSGID_READ);
     Xerxes::Packet p = pingMsg.toPacket();
-    Xerxes::Message pingMsg2(&p);
+    Xerxes::Message pingMsg2(p);
     Xerxes::Packet p2 = pingMsg2.toPacket();
     
     EXPECT_EQ(p2.size(), 7);
@@ -66,4 +68,51 @@ TEST(Message, MessageFromPacket)
     EXPECT_EQ(p2.at(4), 1);
     EXPECT_EQ(p2.at(5), 2);
     EXPECT_EQ(p2.at(6), 0x1D);
-}
\ No newline at end of file
+}
+
+
+namespace
+{
+
+msgid_t lastCalled = 0xFFFF;
+
+void recordPing(const Xerxes::Message &msg) { lastCalled = msg.msgId; }
+void recordSync(const Xerxes::Message &msg) { lastCalled = msg.msgId; }
+void recordRead(const Xerxes::Message &msg) { lastCalled = msg.msgId; }
+
+} // namespace
+
+
+TEST(Message, DispatchTableRoutesByIdAndAddress)
+{
+    using Xerxes::Target;
+
+    // unsorted on purpose, the table is sorted at compile time
+    constexpr auto table = Xerxes::makeDispatchTable({
+        {MSGID_READ, Target::UNICAST, recordRead},
+        {MSGID_SYNC, Target::BROADCAST, recordSync},
+        {MSGID_PING, Target::UNICAST, recordPing},
+    });
+    static_assert(std::is_sorted(table.begin(), table.end(),
+                                 [](const auto &a, const auto &b) { return a.msgId < b.msgId; }));
+
+    const uint8_t address = 0xBA;
+    auto dispatched = [&](uint8_t dst, msgid_t id) {
+        lastCalled = 0xFFFF;
+        return Xerxes::dispatch(table, Xerxes::Message(0x1E, dst, id), address) && lastCalled == id;
+    };
+
+    EXPECT_TRUE(dispatched(address, MSGID_PING));
+    EXPECT_TRUE(dispatched(address, MSGID_READ));
+    EXPECT_TRUE(dispatched(address, MSGID_SYNC));
+
+    // broadcast reaches broadcast handlers only
+    EXPECT_TRUE(dispatched(Xerxes::BROADCAST_ADDR, MSGID_SYNC));
+    EXPECT_FALSE(dispatched(Xerxes::BROADCAST_ADDR, MSGID_PING));
+
+    // other device or unknown message id
+    EXPECT_FALSE(dispatched(0x42, MSGID_PING));
+    EXPECT_FALSE(dispatched(0x42, MSGID_SYNC));
+    EXPECT_FALSE(dispatched(address, MSGID_WRITE));
+    EXPECT_EQ(lastCalled, 0xFFFF);
+}
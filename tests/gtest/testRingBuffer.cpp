@@ -1,6 +1,15 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
 #include "StatisticBuffer.hpp"
+#include "CascadedStatistics.hpp"
+#include "MultiChannelStatistics.hpp"
+#include "ExponentialStatistics.hpp"
+#include "Histogram.hpp"
+#include "AllanDeviation.hpp"
+#include "HampelFilter.hpp"
 
 
 TEST(StatisticBuffer, getStdDevDouble)
@@ -77,4 +86,961 @@ TEST(StatisticBuffer, initializerList)
     EXPECT_FLOAT_EQ(rb.getMin(), -INFINITY);
     EXPECT_FLOAT_EQ(rb.getMax(), 9);
     EXPECT_FLOAT_EQ(rb.getLast(), 8);
-}
\ No newline at end of file
+}
+
+TEST(StatisticBuffer, emptyInitializerList)
+{
+    Xerxes::StatisticBuffer<float> rb(std::initializer_list<float> {});
+    rb.updateStatistics();
+
+    EXPECT_EQ(rb.size(), 0);
+}
+
+TEST(StatisticBuffer, streamingMatchesRecompute)
+{
+    std::mt19937 gen(1);
+    std::normal_distribution<float> dist(1000, 10);
+
+    for(uint32_t len : {1, 7, 100, 1000})
+    {
+        Xerxes::StatisticBuffer<float> streaming(len);
+        Xerxes::StatisticBuffer<float> recompute(len, false);
+        
+        // cover filling, several laps and a partial lap
+        for(uint32_t i = 0; i < 3 * len + len / 2 + 1; i++)
+        {
+            float el = dist(gen);
+            streaming.insertOne(el);
+            recompute.insertOne(el);
+            streaming.updateStatistics();
+            recompute.updateStatistics();
+
+            EXPECT_EQ(streaming.getMin(), recompute.getMin());
+            EXPECT_EQ(streaming.getMax(), recompute.getMax());
+            EXPECT_FLOAT_EQ(streaming.getMean(), recompute.getMean());
+            EXPECT_FLOAT_EQ(streaming.getMedian(), recompute.getMedian());
+            EXPECT_NEAR(streaming.getStdDev(), recompute.getStdDev(), 1e-4 * recompute.getStdDev() + 1e-6);
+        }
+    }
+}
+
+
+TEST(StatisticBuffer, streamingDoesNotDrift)
+{
+    Xerxes::StatisticBuffer<double> rb(100);
+
+    // large offset and a step change, sums must recover after one window
+    for(int i = 0; i < 1000000; i++)
+    {
+        rb.insertOne(1e6 + (i % 2 ? 0.5 : -0.5));
+    }
+    for(int i = 0; i < 100; i++)
+    {
+        rb.insertOne(i % 2 ? 1.5 : 0.5);
+    }
+    rb.updateStatistics();
+
+    EXPECT_FLOAT_EQ(rb.getMean(), 1.0);
+    EXPECT_FLOAT_EQ(rb.getStdDev(), 0.5);
+}
+
+
+TEST(StatisticBuffer, slidingMinMax)
+{
+    Xerxes::StatisticBuffer<int> rb(5);
+
+    // rising then falling, extremes leave the window from the front
+    const int values[] = {1, 2, 3, 4, 5, 6, 7, 6, 5, 4, 3, 2, 1, 1, 1};
+    const int expectedMin[] = {1, 1, 1, 1, 1, 2, 3, 4, 5, 4, 3, 2, 1, 1, 1};
+    const int expectedMax[] = {1, 2, 3, 4, 5, 6, 7, 7, 7, 7, 7, 6, 5, 4, 3};
+
+    for(int i = 0; i < 15; i++)
+    {
+        rb.insertOne(values[i]);
+        rb.updateStatistics();
+        EXPECT_EQ(rb.getMin(), expectedMin[i]) << "at " << i;
+        EXPECT_EQ(rb.getMax(), expectedMax[i]) << "at " << i;
+    }
+}
+
+
+TEST(StatisticBuffer, slidingMinMaxInitializerList)
+{
+    Xerxes::StatisticBuffer<float> rb {3, -1, 2};
+    rb.insertOne(0);  // evicts 3
+    rb.updateStatistics();
+    EXPECT_EQ(rb.getMax(), 2);
+    rb.insertOne(0);  // evicts -1
+    rb.updateStatistics();
+    EXPECT_EQ(rb.getMin(), 0);
+}
+
+
+TEST(StatisticBuffer, percentilesMatchSortedWindow)
+{
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> dist(0, 20);  // many ties, like ADC codes
+
+    for(uint32_t len : {1, 2, 10, 33, 256})
+    {
+        Xerxes::StatisticBuffer<int> rb(len);
+        std::vector<int> window;
+
+        for(uint32_t i = 0; i < 4 * len; i++)
+        {
+            int el = dist(gen);
+            rb.insertOne(el);
+            window.push_back(el);
+            if(window.size() > len)
+            {
+                window.erase(window.begin());
+            }
+
+            std::vector<int> sorted(window);
+            std::sort(sorted.begin(), sorted.end());
+            for(float percent : {0.0f, 5.0f, 50.0f, 95.0f, 100.0f})
+            {
+                double rank = percent / 100.0 * (sorted.size() - 1);
+                size_t lo = static_cast<size_t>(rank);
+                size_t hi = std::min(lo + 1, sorted.size() - 1);
+                double expected = sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+                EXPECT_FLOAT_EQ(rb.getPercentile(percent), expected) << "p" << percent << " len " << len;
+            }
+        }
+    }
+}
+
+
+TEST(StatisticBuffer, getPercentiles)
+{
+    Xerxes::StatisticBuffer<float> rb(101);
+    for(int i = 100; i >= 0; i--)
+    {
+        rb.insertOne(i);
+    }
+    rb.setPercentiles(10, 90);
+    rb.updateStatistics();
+
+    float low, median, high;
+    rb.getPercentiles(&low, &median, &high);
+    EXPECT_FLOAT_EQ(low, 10);
+    EXPECT_FLOAT_EQ(median, 50);
+    EXPECT_FLOAT_EQ(high, 90);
+}
+
+
+TEST(StatisticBuffer, fixedMatchesDynamic)
+{
+    Xerxes::StatisticBuffer<float, 16> fixed;
+    Xerxes::StatisticBuffer<float> dynamic(16);
+
+    for(int i = 0; i < 100; i++)
+    {
+        float el = (i * 37) % 23;
+        fixed.insertOne(el);
+        dynamic.insertOne(el);
+    }
+    fixed.updateStatistics();
+    dynamic.updateStatistics();
+
+    EXPECT_EQ(fixed.getMin(), dynamic.getMin());
+    EXPECT_EQ(fixed.getMax(), dynamic.getMax());
+    EXPECT_EQ(fixed.getMean(), dynamic.getMean());
+    EXPECT_EQ(fixed.getStdDev(), dynamic.getStdDev());
+    EXPECT_EQ(fixed.getMedian(), dynamic.getMedian());
+}
+
+
+TEST(RingBuffer, segmentsInChronologicalOrder)
+{
+    Xerxes::RingBuffer<int> rb(5);
+    auto window = [&rb]()
+    {
+        std::vector<int> fromSegments;
+        auto segments = rb.segments();
+        fromSegments.insert(fromSegments.end(), segments.first.begin(), segments.first.end());
+        fromSegments.insert(fromSegments.end(), segments.second.begin(), segments.second.end());
+
+        std::vector<int> fromIterator;
+        for(const int &el : rb)
+        {
+            fromIterator.push_back(el);
+        }
+        EXPECT_EQ(fromSegments, fromIterator);
+        EXPECT_EQ(fromSegments.size(), rb.size());
+        return fromSegments;
+    };
+
+    EXPECT_TRUE(window().empty());
+
+    rb.insertOne(1);
+    rb.insertOne(2);
+    EXPECT_EQ(window(), std::vector<int>({1, 2}));
+    EXPECT_TRUE(rb.segments().second.empty());
+
+    rb.insertMany(std::vector<int>({3, 4, 5}));
+    EXPECT_EQ(window(), std::vector<int>({1, 2, 3, 4, 5}));
+    EXPECT_TRUE(rb.segments().second.empty());
+
+    // wrapped, views point into the buffer
+    rb.insertMany(std::vector<int>({6, 7}));
+    EXPECT_EQ(window(), std::vector<int>({3, 4, 5, 6, 7}));
+    EXPECT_EQ(rb.segments().first.size(), 3);
+    EXPECT_EQ(rb.segments().second.data() + 2, &rb.getLast() + 1);
+
+    for(int i = 8; i <= 10; i++)
+    {
+        rb.insertOne(i);
+    }
+    EXPECT_EQ(window(), std::vector<int>({6, 7, 8, 9, 10}));
+    EXPECT_TRUE(rb.segments().second.empty());
+
+    Xerxes::RingBuffer<int, 3> full = {1, 2, 3};
+    EXPECT_EQ(std::vector<int>(full.begin(), full.end()), std::vector<int>({1, 2, 3}));
+}
+
+
+template <class Buffer>
+void expectInsertManyMatchesInsertOne(Buffer one, Buffer many)
+{
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int32_t> dist(-5000, 5000);
+
+    // blocks shorter, equal and longer than the window, crossing the end of the ring
+    for(size_t count : {1, 3, 0, 7, 16, 5, 40, 9, 15, 2, 16, 1})
+    {
+        std::vector<int32_t> block(count);
+        for(auto &el : block)
+        {
+            el = dist(gen);
+            one.insertOne(el);
+        }
+        many.insertMany(std::span<const int32_t>(block));
+
+        one.updateStatistics();
+        many.updateStatistics();
+        EXPECT_EQ(one.getLast(), many.getLast()) << count;
+        EXPECT_EQ(one.getMin(), many.getMin()) << count;
+        EXPECT_EQ(one.getMax(), many.getMax()) << count;
+        EXPECT_EQ(one.getMean(), many.getMean()) << count;
+        EXPECT_EQ(one.getStdDev(), many.getStdDev()) << count;
+        EXPECT_EQ(one.getMedian(), many.getMedian()) << count;
+        EXPECT_EQ(one.getPercentile(5), many.getPercentile(5)) << count;
+    }
+}
+
+
+TEST(StatisticBuffer, insertManyMatchesInsertOne)
+{
+    // integer sums are exact, sums of a block must not differ from single inserts
+    expectInsertManyMatchesInsertOne(Xerxes::StatisticBuffer<int32_t, 16, int64_t>(),
+                                     Xerxes::StatisticBuffer<int32_t, 16, int64_t>());
+    expectInsertManyMatchesInsertOne(Xerxes::StatisticBuffer<int32_t, 0, int64_t>(16),
+                                     Xerxes::StatisticBuffer<int32_t, 0, int64_t>(16));
+    expectInsertManyMatchesInsertOne(Xerxes::StatisticBuffer<int32_t, 0, int64_t>(16, false),
+                                     Xerxes::StatisticBuffer<int32_t, 0, int64_t>(16, false));
+}
+
+
+TEST(StatisticBuffer, insertManyIntoEmptyBuffer)
+{
+    // default constructed buffer has no room, a block is dropped like a single insert
+    Xerxes::StatisticBuffer<float> rb;
+    const float block[] = {1, 2, 3};
+
+    rb.insertMany(block, 3);
+    rb.updateStatistics();
+    EXPECT_EQ(rb.size(), 0);
+}
+
+
+TEST(RingBuffer, insertManyWrapsAround)
+{
+    Xerxes::RingBuffer<int, 5> rb;
+    const int block[] = {1, 2, 3, 4, 5, 6, 7};
+
+    rb.insertMany(block, 3);
+    EXPECT_EQ(rb.getLast(), 3);
+    rb.insertMany(block + 3, 4);   // 6, 7 wrap to the start
+    EXPECT_EQ(rb.getLast(), 7);
+    rb.insertMany(block, 7);       // only 3..7 are kept
+    EXPECT_EQ(rb.getLast(), 7);
+    rb.insertOne(8);
+    EXPECT_EQ(rb.getLast(), 8);
+}
+
+
+TEST(RingBuffer, fixedSizeIsClampedToCapacity)
+{
+    // more than N would write past the array, the buffer holds the last N
+    Xerxes::RingBuffer<int, 4> rb(10);
+    for(int i = 1; i <= 10; i++)
+    {
+        rb.insertOne(i);
+    }
+    EXPECT_EQ(rb.size(), 4);
+    EXPECT_EQ(std::vector<int>(rb.begin(), rb.end()), std::vector<int>({7, 8, 9, 10}));
+
+    Xerxes::RingBuffer<int, 3> list = {1, 2, 3, 4, 5};
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({3, 4, 5}));
+
+    Xerxes::StatisticBuffer<int32_t, 4, int64_t> stats(10);
+    for(int i = 1; i <= 10; i++)
+    {
+        stats.insertOne(i);
+    }
+    stats.updateStatistics();
+    EXPECT_EQ(stats.getMin(), 7);
+    EXPECT_EQ(stats.getMax(), 10);
+    EXPECT_EQ(stats.getMedian(), 8.5);
+}
+
+
+template <class Buffer>
+void expectIndependentCopies(Buffer original)
+{
+    for(int i = 0; i < 10; i++)
+    {
+        original.insertOne(i);
+    }
+
+    Buffer copy(original);
+    Buffer assigned;
+    assigned = original;
+
+    // original goes on, copies must keep their own window and streaming state
+    for(int i = 0; i < 10; i++)
+    {
+        original.insertOne(100);
+    }
+
+    for(Buffer *rb : {&copy, &assigned})
+    {
+        rb->insertOne(10);  // window 1..10
+        rb->updateStatistics();
+        EXPECT_FLOAT_EQ(rb->getMin(), 1);
+        EXPECT_FLOAT_EQ(rb->getMax(), 10);
+        EXPECT_FLOAT_EQ(rb->getMean(), 5.5);
+        EXPECT_FLOAT_EQ(rb->getMedian(), 5.5);
+    }
+
+    Buffer moved(std::move(copy));
+    moved.insertOne(11);  // window 2..11
+    moved.updateStatistics();
+    EXPECT_FLOAT_EQ(moved.getMin(), 2);
+    EXPECT_FLOAT_EQ(moved.getMedian(), 6.5);
+
+    original.updateStatistics();
+    EXPECT_FLOAT_EQ(original.getMin(), 100);
+}
+
+
+TEST(StatisticBuffer, copyIsDeepFixed)
+{
+    expectIndependentCopies(Xerxes::StatisticBuffer<float, 10>());
+}
+
+
+TEST(StatisticBuffer, copyIsDeepDynamic)
+{
+    expectIndependentCopies(Xerxes::StatisticBuffer<float>(10));
+}
+
+
+TEST(StatisticBuffer, fixedPointMatchesFloatingPoint)
+{
+    std::mt19937 gen(3);
+    std::normal_distribution<double> dist(1 << 22, 1000);  // 24 bit ADC counts
+
+    for(uint32_t len : {1, 7, 80, 1000})
+    {
+        Xerxes::StatisticBuffer<int32_t, 0, int64_t> fixedPoint(len);
+        Xerxes::StatisticBuffer<int32_t> floatingPoint(len);
+
+        for(uint32_t i = 0; i < 3 * len + 5; i++)
+        {
+            int32_t el = static_cast<int32_t>(dist(gen));
+            fixedPoint.insertOne(el);
+            floatingPoint.insertOne(el);
+        }
+        fixedPoint.updateStatistics();
+        floatingPoint.updateStatistics();
+
+        EXPECT_EQ(fixedPoint.getMin(), floatingPoint.getMin()) << "len " << len;
+        EXPECT_EQ(fixedPoint.getMax(), floatingPoint.getMax()) << "len " << len;
+        EXPECT_FLOAT_EQ(fixedPoint.getMean(), floatingPoint.getMean()) << "len " << len;
+        EXPECT_NEAR(fixedPoint.getStdDev(), floatingPoint.getStdDev(), 1e-5 * floatingPoint.getStdDev() + 1e-6) << "len " << len;
+        EXPECT_EQ(fixedPoint.getMedian(), floatingPoint.getMedian()) << "len " << len;
+    }
+}
+
+
+TEST(StatisticBuffer, fixedPointStdDev)
+{
+    Xerxes::StatisticBuffer<int32_t, 10, int64_t> rb;
+    for(int i = 0; i < 100; i++)
+    {
+        rb.insertOne(i);
+    }
+    rb.updateStatistics();
+    EXPECT_FLOAT_EQ(rb.getMean(), 94.5);
+    EXPECT_FLOAT_EQ(rb.getStdDev(), 2.8722813232690143);
+
+    for(int i = 0; i < 10; i++)
+    {
+        rb.insertOne(-7);
+    }
+    rb.updateStatistics();
+    EXPECT_FLOAT_EQ(rb.getMean(), -7);
+    EXPECT_EQ(rb.getStdDev(), 0);
+}
+
+
+TEST(StatisticBuffer, fixedPointWideProducts)
+{
+    // n * sumSq is 2^70, past int64_t, the sums themselves still fit
+    Xerxes::StatisticBuffer<int32_t, 1024, int64_t> rb;
+    for(int i = 0; i < 1024; i++)
+    {
+        rb.insertOne(i % 2 ? 1 << 25 : -(1 << 25));
+    }
+    rb.updateStatistics();
+    EXPECT_FLOAT_EQ(rb.getMean(), 0);
+    EXPECT_FLOAT_EQ(rb.getStdDev(), 1 << 25);
+
+    EXPECT_FLOAT_EQ(Xerxes::covarianceFromSums<int64_t>(0, 0, -(int64_t(1) << 60), 1024), -(1ll << 50));
+    EXPECT_FLOAT_EQ(Xerxes::covarianceFromSums<int64_t>(1ll << 40, -(1ll << 40), 0, 1024), 1ll << 60);
+}
+
+
+TEST(StatisticBuffer, setScale)
+{
+    Xerxes::StatisticBuffer<int32_t, 0, int64_t> rb {0, 1, 2, 3, 4};
+    rb.setScale(-0.5, 10);
+    rb.updateStatistics();
+
+    float min, max, mean, stdDev, low, median, high;
+    rb.getStatistics(&min, &max, &mean, &stdDev);
+    rb.getPercentiles(&low, &median, &high);
+    EXPECT_FLOAT_EQ(min, 8);
+    EXPECT_FLOAT_EQ(max, 10);
+    EXPECT_FLOAT_EQ(mean, 9);
+    EXPECT_FLOAT_EQ(stdDev, 0.5 * sqrt(2));
+    EXPECT_FLOAT_EQ(median, 9);
+    EXPECT_FLOAT_EQ(low, 8.1);
+    EXPECT_FLOAT_EQ(high, 9.9);
+    EXPECT_FLOAT_EQ(rb.getPercentile(50), 9);
+}
+
+
+/// @brief Every channel gives the same statistics as its own StatisticBuffer
+template <class T, class Sum>
+void expectChannelsMatchBuffers(const float &scale)
+{
+    constexpr uint32_t len = 37;
+    std::mt19937 gen(5);
+    std::normal_distribution<double> dist(1 << 20, 500);
+
+    Xerxes::MultiChannelStatistics<4, T, len, Sum, Xerxes::ORDER_ALL> statistics;
+    std::array<Xerxes::StatisticBuffer<T, len, Sum>, 4> buffers;
+    statistics.setScale(scale, 1);
+    for(auto &buffer : buffers)
+    {
+        buffer.setScale(scale, 1);
+    }
+
+    for(uint32_t i = 0; i < 3 * len + 11; i++)
+    {
+        T sample[4];
+        for(uint32_t ch = 0; ch < 4; ch++)
+        {
+            sample[ch] = static_cast<T>(dist(gen)) * (ch + 1);
+            buffers[ch].insertOne(sample[ch]);
+        }
+        statistics.insert(sample);
+    }
+
+    statistics.updateStatistics();
+    float min[4], max[4], mean[4], stdDev[4], low[4], median[4], high[4];
+    statistics.getStatistics(min, max, mean, stdDev);
+    statistics.getPercentiles(low, median, high);
+
+    for(uint32_t ch = 0; ch < 4; ch++)
+    {
+        buffers[ch].updateStatistics();
+        float bLow, bMedian, bHigh;
+        buffers[ch].getPercentiles(&bLow, &bMedian, &bHigh);
+        EXPECT_EQ(min[ch], buffers[ch].getMin()) << "channel " << ch;
+        EXPECT_EQ(max[ch], buffers[ch].getMax()) << "channel " << ch;
+        EXPECT_EQ(mean[ch], buffers[ch].getMean()) << "channel " << ch;
+        EXPECT_EQ(stdDev[ch], buffers[ch].getStdDev()) << "channel " << ch;
+        EXPECT_EQ(low[ch], bLow) << "channel " << ch;
+        EXPECT_EQ(median[ch], bMedian) << "channel " << ch;
+        EXPECT_EQ(high[ch], bHigh) << "channel " << ch;
+    }
+}
+
+
+TEST(MultiChannelStatistics, matchesStatisticBuffers)
+{
+    expectChannelsMatchBuffers<float, double>(1);
+    expectChannelsMatchBuffers<int32_t, int64_t>(-0.25);
+}
+
+
+TEST(MultiChannelStatistics, channelMask)
+{
+    Xerxes::MultiChannelStatistics<4, float, 8, double, Xerxes::ORDER_EXTREMES> statistics;
+    statistics.setChannelMask(0b1011);
+
+    for(int i = 0; i < 20; i++)
+    {
+        const float sample[4] = {float(i), 2.0f * i, NAN, -1.0f * i};
+        statistics.insert(sample);
+    }
+    EXPECT_EQ(statistics.size(), 8);
+    statistics.updateStatistics();
+
+    // unused channel is left untouched in the destination
+    float mean[4] = {0, 0, 42, 0};
+    float max[4] = {0, 0, 42, 0};
+    statistics.getStatistics(nullptr, max, mean, nullptr);
+    EXPECT_FLOAT_EQ(mean[0], 15.5);
+    EXPECT_FLOAT_EQ(mean[1], 31);
+    EXPECT_EQ(mean[2], 42);
+    EXPECT_FLOAT_EQ(mean[3], -15.5);
+    EXPECT_EQ(max[0], 19);
+    EXPECT_EQ(max[2], 42);
+    EXPECT_EQ(max[3], -12);
+
+    // new mask starts over
+    statistics.setChannelMask(0b0001);
+    EXPECT_EQ(statistics.size(), 0);
+}
+
+TEST(MultiChannelStatistics, orderStatisticsAreOptIn)
+{
+    Xerxes::MultiChannelStatistics<2, float, 100> sums;
+    Xerxes::MultiChannelStatistics<2, float, 100, double, Xerxes::ORDER_EXTREMES> extremes;
+    Xerxes::MultiChannelStatistics<2, float, 100, double, Xerxes::ORDER_ALL> all;
+    EXPECT_LT(sizeof(sums), sizeof(extremes));
+    EXPECT_LT(sizeof(extremes), sizeof(all));
+
+    for(int i = 0; i < 10; i++)
+    {
+        const float sample[2] = {float(i), -float(i)};
+        sums.insert(sample);
+        extremes.insert(sample);
+    }
+    sums.updateStatistics();
+    extremes.updateStatistics();
+
+    // statistics which are not kept are NaN, the sums are not affected
+    float min[2], max[2], mean[2], median[2], low[2], high[2];
+    sums.getStatistics(min, max, mean, nullptr);
+    sums.getPercentiles(low, median, high);
+    EXPECT_FLOAT_EQ(mean[0], 4.5);
+    EXPECT_TRUE(std::isnan(min[0]) && std::isnan(max[1]));
+    EXPECT_TRUE(std::isnan(low[0]) && std::isnan(median[0]) && std::isnan(high[1]));
+
+    extremes.getStatistics(min, max, mean, nullptr);
+    extremes.getPercentiles(low, median, high);
+    EXPECT_EQ(min[1], -9);
+    EXPECT_EQ(max[0], 9);
+    EXPECT_TRUE(std::isnan(median[1]));
+}
+
+TEST(MultiChannelStatistics, timeWindow)
+{
+    constexpr uint32_t len = 50;
+    constexpr uint32_t windowUs = 100'000;
+    std::mt19937 gen(11);
+    std::normal_distribution<double> dist(1e6, 20);
+    std::uniform_int_distribution<uint32_t> gap(500, 8000);
+
+    Xerxes::MultiChannelStatistics<1, float, len, double, Xerxes::ORDER_ALL> statistics;
+    statistics.setWindowUs(windowUs);
+    std::vector<std::pair<uint64_t, float>> history;
+
+    // cycle time changes, window follows the time; long gaps empty it, fast cycles fill the ring
+    uint64_t timeUs = (1ull << 32) - 300'000;  // 32 bit timestamps wrap on the way
+    for(uint32_t i = 0; i < 2000; i++)
+    {
+        timeUs += (i % 500 == 499) ? 250'000 : gap(gen) / ((i / 250) % 4 == 3 ? 8 : 1);
+        const float el = dist(gen);
+        statistics.insert(&el, timeUs);
+        history.emplace_back(timeUs, el);
+
+        std::vector<float> window;
+        for(auto it = history.rbegin(); it != history.rend() && window.size() < len && timeUs - it->first < windowUs; it++)
+        {
+            window.push_back(it->second);
+        }
+        ASSERT_EQ(statistics.size(), window.size()) << "sample " << i;
+
+        statistics.updateStatistics();
+        float min, max, mean, stdDev, median;
+        statistics.getStatistics(&min, &max, &mean, &stdDev, &median);
+
+        double expectedMean = 0;
+        for(auto el : window) expectedMean += el;
+        expectedMean /= window.size();
+        double sq = 0;
+        for(auto el : window) sq += (el - expectedMean) * (el - expectedMean);
+        std::sort(window.begin(), window.end());
+
+        EXPECT_FLOAT_EQ(mean, expectedMean) << "sample " << i;
+        EXPECT_NEAR(stdDev, sqrt(sq / window.size()), 1e-3) << "sample " << i;
+        EXPECT_EQ(min, window.front()) << "sample " << i;
+        EXPECT_EQ(max, window.back()) << "sample " << i;
+    }
+}
+
+TEST(MultiChannelStatistics, trend)
+{
+    constexpr uint32_t len = 40;
+    std::mt19937 gen(13);
+    std::normal_distribution<double> noise(0, 0.5);
+    std::uniform_int_distribution<uint32_t> gap(5'000, 50'000);
+
+    Xerxes::MultiChannelStatistics<2, int32_t, len, int64_t> statistics;
+    statistics.setWindowUs(1'000'000);
+    std::vector<std::pair<uint64_t, int32_t>> history;
+
+    float slope[2], intercept[2];
+    int32_t first[2] = {7, 7};
+    statistics.insert(first, 1'000);
+    statistics.updateStatistics();
+    statistics.getTrend(slope, intercept);
+    EXPECT_TRUE(std::isnan(slope[0]));
+
+    // ramp of 1000 counts/s, windows by count and by time, 32 bit timestamps wrap on the way
+    statistics.clear();
+    uint64_t timeUs = (1ull << 32) - 3'000'000;
+    for(uint32_t i = 0; i < 1000; i++)
+    {
+        timeUs += gap(gen);
+        const int32_t el[2] = {static_cast<int32_t>(timeUs / 1000 % 100'000 + noise(gen)), -5};
+        statistics.insert(el, timeUs);
+        history.emplace_back(timeUs, el[0]);
+
+        // brute force least squares over the window
+        double n = 0, st = 0, sx = 0, stt = 0, stx = 0;
+        for(auto it = history.rbegin(); it != history.rend() && n < len && timeUs - it->first < 1'000'000; it++)
+        {
+            const double t = (static_cast<double>(it->first) - timeUs) * 1e-6;
+            n++;
+            st += t;
+            sx += it->second;
+            stt += t * t;
+            stx += t * it->second;
+        }
+        const double expectedSlope = (n * stx - st * sx) / (n * stt - st * st);
+        const double expectedIntercept = (sx - expectedSlope * st) / n;
+
+        statistics.updateStatistics();
+        statistics.getTrend(slope, intercept, 3600);
+        if(n < 2)
+        {
+            continue;
+        }
+        EXPECT_NEAR(slope[0], expectedSlope * 3600, 1e-4 * fabs(expectedSlope * 3600)) << "sample " << i;
+        EXPECT_FLOAT_EQ(intercept[0], expectedIntercept) << "sample " << i;
+        EXPECT_EQ(slope[1], 0) << "sample " << i;
+        EXPECT_EQ(intercept[1], -5) << "sample " << i;
+    }
+}
+
+
+template <class T, class Sum>
+void expectCovarianceOfWindow(float scale)
+{
+    constexpr uint32_t len = 32;
+    std::mt19937 gen(17);
+    std::normal_distribution<double> common(0, 100);
+    std::normal_distribution<double> noise(0, 10);
+
+    Xerxes::MultiChannelStatistics<4, T, len, Sum> statistics;
+    statistics.setScale(scale);
+    statistics.setChannelMask(0b1011);
+    std::vector<std::array<T, 4>> history;
+
+    // ch1 follows ch0, ch3 is inverted ch0, ch2 is unused; several laps of the ring
+    for(uint32_t i = 0; i < 200; i++)
+    {
+        const double c = 1e4 + common(gen);
+        const std::array<T, 4> el = {static_cast<T>(c + noise(gen)),
+                                     static_cast<T>(2 * c + noise(gen)),
+                                     static_cast<T>(noise(gen)),
+                                     static_cast<T>(-c + noise(gen))};
+        statistics.insert(el.data());
+        history.push_back(el);
+    }
+
+    float covariance[10];
+    std::fill(std::begin(covariance), std::end(covariance), 42.0f);
+    statistics.updateStatistics();
+    statistics.getCovariance(covariance);
+
+    // brute force population covariance of the last len samples
+    const std::vector<std::array<T, 4>> window(history.end() - len, history.end());
+    double mean[4] {};
+    for(const auto &el : window)
+    {
+        for(uint32_t ch = 0; ch < 4; ch++) mean[ch] += static_cast<double>(el[ch]) / len;
+    }
+
+    uint32_t i = 0;
+    for(uint32_t x = 0; x < 4; x++)
+    {
+        for(uint32_t y = x; y < 4; y++, i++)
+        {
+            if(x == 2 || y == 2)
+            {
+                EXPECT_EQ(covariance[i], 42) << x << ", " << y;
+                continue;
+            }
+            double expected = 0;
+            for(const auto &el : window) expected += (el[x] - mean[x]) * (el[y] - mean[y]) / len;
+            expected *= scale * scale;
+            EXPECT_NEAR(covariance[i], expected, 1e-4 * fabs(expected)) << x << ", " << y;
+        }
+    }
+
+    // diagonal is the variance
+    float stdDev[4];
+    statistics.getStatistics(nullptr, nullptr, nullptr, stdDev);
+    EXPECT_NEAR(covariance[0], stdDev[0] * stdDev[0], 1e-4 * covariance[0]);
+    EXPECT_NEAR(covariance[9], stdDev[3] * stdDev[3], 1e-4 * covariance[9]);
+}
+
+
+TEST(MultiChannelStatistics, covariance)
+{
+    expectCovarianceOfWindow<float, double>(1);
+    expectCovarianceOfWindow<int32_t, int64_t>(-0.5);
+
+    // empty window
+    Xerxes::MultiChannelStatistics<2, float, 8> statistics;
+    float covariance[3];
+    statistics.updateStatistics();
+    statistics.getCovariance(covariance);
+    EXPECT_TRUE(std::isnan(covariance[1]));
+}
+
+
+TEST(ExponentialStatistics, alphaFromTimeConstant)
+{
+    using Statistics = Xerxes::ExponentialStatistics<1>;
+    EXPECT_EQ(Statistics::alphaFor(0, 1000), 1);
+    EXPECT_DOUBLE_EQ(Statistics::alphaFor(1000, 1000), 1 - exp(-1));
+    // period / tau for long time constants
+    EXPECT_NEAR(Statistics::alphaFor(3'600'000'000, 1000), 1000 / 3.6e9, 1e-12);
+}
+
+
+TEST(ExponentialStatistics, converges)
+{
+    std::mt19937 gen(7);
+    std::normal_distribution<double> dist(5000, 3);
+
+    Xerxes::ExponentialStatistics<2> statistics;
+    statistics.setChannelMask(0b01);
+    statistics.setTimeConstant(100'000, 100);  // ~1000 samples
+
+    float mean[2] = {0, 42}, stdDev[2] = {0, 42};
+    statistics.getStatistics(mean, stdDev);
+    EXPECT_TRUE(std::isnan(mean[0]));
+
+    for(int i = 0; i < 20000; i++)
+    {
+        const float sample[2] = {static_cast<float>(dist(gen)), NAN};
+        statistics.insert(sample);
+    }
+    statistics.getStatistics(mean, stdDev);
+    EXPECT_NEAR(mean[0], 5000, 0.5);
+    EXPECT_NEAR(stdDev[0], 3, 0.3);
+    EXPECT_EQ(mean[1], 42);
+}
+
+TEST(CascadedStatistics, windowsMatchSamples)
+{
+    constexpr uint64_t periodUs = 1000;  // 1 kHz
+    Xerxes::CascadedStatistics<float> windows;
+    std::vector<float> all;
+
+    // 75 s of samples, value is the second of the sample plus a ramp inside the second
+    uint64_t t = 0;
+    for(; t < 75'000'000; t += periodUs)
+    {
+        float el = 1000 + static_cast<float>(t / 1'000'000) + (t % 1'000'000) / 1e6f;
+        windows.insert(el, t);
+        all.push_back(el);
+    }
+
+    auto expectWindow = [&](Xerxes::CascadedStatistics<float>::Resolution resolution, uint64_t fromS, uint64_t toS)
+    {
+        std::vector<float> window(all.begin() + fromS * 1000, all.begin() + toS * 1000);
+        double mean = 0;
+        for(auto el : window) mean += el;
+        mean /= window.size();
+        double sq = 0;
+        for(auto el : window) sq += (el - mean) * (el - mean);
+
+        float m, s, lo, hi;
+        windows.getStatistics(resolution, &m, &s, &lo, &hi);
+        EXPECT_FLOAT_EQ(m, mean);
+        EXPECT_NEAR(s, sqrt(sq / window.size()), 1e-4);
+        EXPECT_EQ(lo, *std::min_element(window.begin(), window.end()));
+        EXPECT_EQ(hi, *std::max_element(window.begin(), window.end()));
+        EXPECT_EQ(windows.getSummary(resolution).count, window.size());
+    };
+
+    // running second is 74, minute is made of completed ten-second blocks 10..70
+    expectWindow(Xerxes::CascadedStatistics<float>::SECOND, 73, 74);
+    expectWindow(Xerxes::CascadedStatistics<float>::TEN_SECONDS, 64, 74);
+    expectWindow(Xerxes::CascadedStatistics<float>::MINUTE, 10, 70);
+}
+
+
+TEST(CascadedStatistics, gapsLeaveEmptyWindows)
+{
+    Xerxes::CascadedStatistics<int> windows;
+    float mean, stdDev, min, max;
+
+    windows.getStatistics(windows.SECOND, &mean, &stdDev, &min, &max);
+    EXPECT_TRUE(std::isnan(mean));
+
+    EXPECT_FALSE(windows.insert(5, 500'000));
+    EXPECT_TRUE(windows.insert(7, 3'200'000));  // seconds 1 and 2 have no samples
+
+    windows.getStatistics(windows.SECOND, &mean, &stdDev, &min, &max);
+    EXPECT_TRUE(std::isnan(mean));
+    windows.getStatistics(windows.TEN_SECONDS, &mean, &stdDev, &min, &max);
+    EXPECT_EQ(mean, 5);
+    EXPECT_EQ(stdDev, 0);
+
+    // longer gap than a minute drops everything
+    windows.insert(9, 200'000'000);
+    windows.insert(9, 201'000'000);
+    windows.getStatistics(windows.TEN_SECONDS, &mean, &stdDev, &min, &max);
+    EXPECT_EQ(mean, 9);
+    EXPECT_EQ(windows.getSummary(windows.TEN_SECONDS).count, 1);
+}
+
+
+TEST(Histogram, binsUnderflowAndOverflow)
+{
+    Xerxes::Histogram<32> histogram;
+    histogram.insert(1);
+    EXPECT_FALSE(histogram.enabled());
+    EXPECT_EQ(histogram.getUnderflow() + histogram.getOverflow(), 0);
+
+    // buckets [-1, -0.5), [-0.5, 0), ... [14.5, 15)
+    histogram.setRange(-1, 0.5);
+    for(float el : {-1.0f, -0.75f, -0.5f, 0.0f, 14.99f, 15.0f, -1.01f, NAN})
+    {
+        histogram.insert(el);
+    }
+    EXPECT_EQ(histogram.getBins()[0], 2);
+    EXPECT_EQ(histogram.getBins()[1], 1);
+    EXPECT_EQ(histogram.getBins()[2], 1);
+    EXPECT_EQ(histogram.getBins()[31], 1);
+    EXPECT_EQ(histogram.getUnderflow(), 1);
+    EXPECT_EQ(histogram.getOverflow(), 1);
+
+    uint32_t total = 0;
+    for(auto bin : histogram.getBins()) total += bin;
+    EXPECT_EQ(total, 5);
+
+    // new range drops counts, NaN width disables
+    EXPECT_TRUE(histogram.hasRange(-1, 0.5));
+    histogram.setRange(NAN, NAN);
+    EXPECT_TRUE(histogram.hasRange(NAN, NAN));
+    EXPECT_FALSE(histogram.enabled());
+    histogram.insert(0);
+    EXPECT_EQ(histogram.getBins()[2], 0);
+    EXPECT_EQ(histogram.getUnderflow() + histogram.getOverflow(), 0);
+}
+
+
+TEST(AllanDeviation, rampAndWhiteNoise)
+{
+    Xerxes::AllanDeviation<6> ramp;
+    Xerxes::AllanDeviation<6> noise;
+    std::mt19937 gen(17);
+    std::normal_distribution<float> dist(0, 1);
+
+    float deviation[6];
+    ramp.getDeviation(deviation);
+    EXPECT_TRUE(std::isnan(deviation[0]));
+
+    // 100 Hz for 20 min, tau up to 32 s
+    for(uint64_t timeUs = 0; timeUs < 1200'000'000; timeUs += 10'000)
+    {
+        ramp.insert(timeUs * 1e-6f * 0.5f, timeUs);
+        noise.insert(dist(gen), timeUs);
+    }
+
+    // averages of a ramp are tau * slope apart, deviation is tau * slope / sqrt(2)
+    ramp.getDeviation(deviation);
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        const float tau = 1u << i;
+        EXPECT_NEAR(deviation[i], tau * 0.5f / sqrt(2), 1e-3 * tau) << "tau " << tau;
+    }
+
+    // white noise averages down with 1 / sqrt(samples in tau), half overlapping differences
+    // take a block each, the running block is not complete yet
+    noise.getDeviation(deviation);
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        const float tau = 1u << i;
+        EXPECT_EQ(noise.getDifferences(i), 2400 / (1u << i) - 4) << "tau " << tau;
+        EXPECT_NEAR(deviation[i], 1 / sqrt(100 * tau), 0.25 / sqrt(100 * tau)) << "tau " << tau;
+    }
+
+    // gap restarts the blocks, keeps the sums
+    noise.insert(0, 1300'000'000);
+    const uint32_t differences = noise.getDifferences(0);
+    noise.insert(0, 1300'600'000);
+    noise.insert(0, 1301'100'000);
+    noise.insert(0, 1301'600'000);
+    EXPECT_EQ(noise.getDifferences(0), differences);
+    noise.insert(0, 1302'100'000);
+    EXPECT_EQ(noise.getDifferences(0), differences + 1);
+}
+
+
+TEST(HampelFilter, replacesSpikesWithMedian)
+{
+    Xerxes::HampelFilter<2, int32_t, 5> filter;
+    filter.setChannelMask(0b01);
+
+    // window fills up first, spikes pass until then
+    for(int32_t el : {10, 12, 100, 11, 9})
+    {
+        int32_t sample[2] = {el, el};
+        EXPECT_EQ(filter.filter(sample), 0);
+        EXPECT_EQ(sample[0], el);
+    }
+
+    // window 12, 100, 11, 9, 200 - median 12, MAD 1
+    int32_t spike[2] = {200, 200};
+    EXPECT_EQ(filter.filter(spike), 0b01);
+    EXPECT_EQ(spike[0], 12);
+    EXPECT_EQ(spike[1], 200);   // channel is not filtered
+
+    // within 3 * 1.4826 MAD of the median
+    int32_t step[2] = {14, 14};
+    EXPECT_EQ(filter.filter(step), 0);
+    EXPECT_EQ(step[0], 14);
+
+    // equal values have no spread, nothing is an outlier
+    filter.clear();
+    for(int32_t el : {5, 5, 5, 5, 5, 6})
+    {
+        int32_t sample[2] = {el, el};
+        EXPECT_EQ(filter.filter(sample), 0);
+    }
+}
@@ -17,7 +17,13 @@ _log = logging.getLogger(__name__)
 
 
 def get_serial_com() -> Serial:
-    if os.name == "nt":
+    port = os.environ.get("XERXES_PORT")
+    if port:
+        # e.g. pty of the host build: XERXES_HOST_PTY_LINK=/tmp/xerxes ./SCL3300
+        com = Serial(port=port, baudrate=115200, timeout=0.02)
+        _log.info(f"Using serial port {com.port} from XERXES_PORT")
+
+    elif os.name == "nt":
         # som na windows
         com = Serial(port="COM15", baudrate=115200, timeout=0.02)
 